@@ -1,7 +1,7 @@
-#version 460 core
-out vec4 FragColor;
-
-void main()
-{
-    FragColor = vec4(1.0f);
+#version 460 core
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(1.0f);
 }
\ No newline at end of file
@@ -1,12 +1,12 @@
-#version 460 core
-out vec4 FragColor;
-
-in vec2 texCoord;
-
-uniform sampler2D texture1;
-uniform sampler2D texture2;
-
-void main()
-{
-    FragColor = mix(texture(texture1, texCoord), texture(texture2, texCoord), 0.2f);
+#version 460 core
+out vec4 FragColor;
+
+in vec2 texCoord;
+
+uniform sampler2D texture1;
+uniform sampler2D texture2;
+
+void main()
+{
+    FragColor = mix(texture(texture1, texCoord), texture(texture2, texCoord), 0.2f);
 }
\ No newline at end of file
@@ -1,1436 +1,2765 @@
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-#include "stb_image.h"
-#include "FastNoise.h"
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include <glm/gtc/noise.hpp>
-#include <glm/gtc/random.hpp>
-#include <glm/gtx/normal.hpp>
-
-#include "shader.h"
-#include "camera.h"
-
-#include <iostream>
-
-using namespace std;
-
-void framebuffer_size_callback(GLFWwindow* window, int width, int height);
-void mouse_callback(GLFWwindow* window, double xpos, double ypos);
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
-void processInput(GLFWwindow *window);
-vector<float> GenerateMeshVertices(unsigned int width, unsigned int height);
-vector<unsigned int> GenerateMeshIndices(unsigned int width, unsigned int height);
-void GenerateMeshTextures(unsigned int width, unsigned int height);
-void GenerateBaseTextures(unsigned int width, unsigned int height);
-void GenerateSquarePillar(unsigned int width, unsigned int height);
-void GenerateSphere(unsigned int width, unsigned int height);
-unsigned int GetLocation(unsigned int i, unsigned int j);
-
-// window settings
-const unsigned int SCR_WIDTH = 1980;
-const unsigned int SCR_HEIGHT = 1018;
-
-// timing
-float deltaTime = 0.0f;	// time between current frame and last frame
-float lastFrame = 0.0f;
-
-// mesh settings
-const unsigned int MESH_WIDTH = 1024;
-const unsigned int MESH_HEIGHT = MESH_WIDTH;
-const unsigned int MESH_TOTAL_SIZE = 5;
-const float MESH_SCALE = (float)MESH_TOTAL_SIZE / (float)MESH_WIDTH;
-unsigned int meshVAO, meshVBO, meshEBO;
-unsigned int wMeshVAO, wMeshVBO, wMeshEBO;
-vector<unsigned int> meshIndices;
-vector<float> meshVertices;
-
-// camera
-// Camera above the middle of the map
-//Camera camera(glm::vec3(0.0f, 1.5f * MESH_TOTAL_SIZE, 0.0f));
-
-// Camera just above the ground, focusing on distinction between vegetated and non-vegetated erosion
-//Camera camera(glm::vec3(-1.0f * MESH_TOTAL_SIZE / 2.0f, 0.02f * MESH_TOTAL_SIZE, -1.1f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 50, -15);
-//Camera camera(glm::vec3(-0.43f * MESH_TOTAL_SIZE / 2.0f, 0.003f * MESH_TOTAL_SIZE, -0.37f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 75, -15);
-
-// Camera zoomed in on three pillars
-//Camera camera(glm::vec3(-0.6f * MESH_TOTAL_SIZE / 2.0f, 0.3f * MESH_TOTAL_SIZE, -0.6f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -35);
-
-// Camera zoomed in on entire terrain
-//Camera camera(glm::vec3(-1.5f * MESH_TOTAL_SIZE / 2.0f, 1.3f * MESH_TOTAL_SIZE, -1.5f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -55);
-
-// Camera focused on entire terrain focusing on a single edge
-Camera camera(glm::vec3(-1.8f * MESH_TOTAL_SIZE / 2.0f, 0.8f * MESH_TOTAL_SIZE, 0.0f), glm::vec3(0, 1, 0), 0, -45);
-
-// Camera zoomed-in on sphere terrain source flow
-//Camera camera(glm::vec3(-0.8f * MESH_TOTAL_SIZE / 2.0f, 0.3f * MESH_TOTAL_SIZE, -0.8f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -35);
-
-float lastX = SCR_WIDTH / 2.0f;
-float lastY = SCR_HEIGHT / 2.0f;
-bool firstMouse = true;
-int cameraChange = 0;
-
-// texture settings
-const float HEIGHT_SCALING_VALUE = 10.0f;
-vector<float> CDTexture(MESH_WIDTH * MESH_HEIGHT * 4);
-vector<float> EmptyTexture(MESH_WIDTH * MESH_HEIGHT * 4);
-unsigned int CDTextureID, WTextureID, FTextureID, VTextureID, RTextureID, STextureID, SCTextureID;
-unsigned int tempCDTextureID, tempWTextureID, tempFTextureID, tempVTextureID, tempRTextureID, tempSTextureID, tempSCTextureID;
-
-// texture settings
-const GLenum TEXTURE_FORMAT = GL_RGBA;
-const GLenum INTERNAL_TEXTURE_FORMAT = GL_RGBA32F;
-
-// compute shader settings
-const unsigned int WORK_GROUP_SIZE_X = 32;
-const unsigned int WORK_GROUP_SIZE_Y = 32;
-const unsigned int WORK_GROUP_SIZE_Z = MESH_WIDTH; // Must be kept as MESH_WIDTh so that the number of groups in z remains 1
-const unsigned int NUM_GROUPS_X = MESH_WIDTH / WORK_GROUP_SIZE_X;
-const unsigned int NUM_GROUPS_Y = MESH_WIDTH / WORK_GROUP_SIZE_Y;
-const unsigned int NUM_GROUPS_Z = MESH_WIDTH / WORK_GROUP_SIZE_Z;
-
-// debug settings
-bool drawPolygon = false;
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-//////////////////////////////  Main Simulation Settings  //////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Lighting Settings
-glm::vec3 lightDirection(-1.0, -1.0, -1.0);
-
-// Movie Mode Setting
-bool isMovieMode = false;
-bool isCameraMoving = false;
-
-// Vegetation Boolean Values
-bool isVegetation = true;
-bool isVegetationSeed = false;
-
-// Terrain Generation Settings
-const int terrainSeed = 8675309; //4120412;
-const int vegetationSeed = 1337;
-float maxVegetationValue = 0.0035f;
-const bool isSquarePillarTerrain = false;
-const bool isSphereTerrain = false;
-
-// Terrain Rendering Fragment Shader Values
-const float baseTerrainAmplitude = 0.1f;
-const float baseTerrainFrequency = 10.0f;
-const float baseGrassAmplitude = 0.1f;
-const float baseGrassFrequency = 5.0f;
-
-// Boolean Settings For Erosion Effects
-bool isSourceFlow = true;
-bool isRain = true;
-bool isErosion = true;
-bool isRegolith = true;
-bool isSoilFlow = true;
-
-// Water Increment Source and Rain settings
-const unsigned int SOURCE_FLOW_CUTOFF_TIME = (unsigned int)(15 * max(1.0f, MESH_WIDTH / 256.0f));
-const unsigned int RAIN_CUTOFF_TIME = (unsigned int)(15 * max(1.0f, MESH_WIDTH / 256.0f));
-const float Km = 0.00005f; // Regolith Max Height Constant
-int numberOfRaindrops = 1;
-int rainRadius;
-
-// Flux Update Settings
-const float wKf = 0.999f; // Water Friction Coefficient
-const float rKf = 0.3f; // Regolith Frition Coefficient
-const float g = 9.81f; // Gravity Coefficient
-
-// Soil Flow Settings
-const float Kt = 100.0f;
-const float terrainTalusAngle = 35.0f;
-const float vegetationTalusAngle = 50.0f;
-const unsigned int SOIL_FLOW_CUTOFF_TIME = (unsigned int)(45000 * max(1.0f, MESH_WIDTH / 256.0f));
-
-// Sediment Erosion and Deposition Settings
-const float Kdmax = 0.007f; // Max Erosion Ramp Constant
-const float Kc = 0.0004f; // Sediment Capacity Constant
-const float Ks = 0.00003f; // Dissolving Constant
-const float Kd = 0.00003f; // Deposition Constant
-
-// Evaporation Settings
-const float Ke = 3; // Evaporation Constant
-
-// Simulation Settings
-const float TIME_STEP = min(0.002f, 0.002f * (256.0f / MESH_WIDTH));
-const float PIPE_LENGTH = 256.0f / MESH_WIDTH;
-const float PIPE_CROSS_SECTION_AREA = 20 * PIPE_LENGTH;
-
-////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Key Press Settings
-const float KEY_PRESS_DELAY = 1.0f;
-float pLastPressTime = 0;
-
-int main()
-{
-	// glfw: initialize and configure
-	// ------------------------------
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // uncomment this statement to fix compilation on OS X
-#endif
-
-	// glfw window creation
-	// --------------------
-	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "OpenGLWaterSimulation", NULL, NULL);
-	glfwMaximizeWindow(window);
-
-	if (window == NULL)
-	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return -1;
-	}
-	glfwMakeContextCurrent(window);
-	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-	glfwSetCursorPosCallback(window, mouse_callback);
-	glfwSetScrollCallback(window, scroll_callback);
-
-	// tell GLFW to capture our mouse
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
-	// glad: load all OpenGL function pointers
-	// ---------------------------------------
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-	{
-		std::cout << "Failed to initialize GLAD" << std::endl;
-		return -1;
-	}
-
-	// configure global opengl state
-	// -----------------------------
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// build and compile our shader zprogram
-	// ------------------------------------
-	Shader waterIncrementComputeShader("waterIncrement.ComputeShader");
-	Shader fluxUpdateComputeShader("fluxUpdate.ComputeShader");
-	Shader heightUpdateComputeShader("heightUpdate.ComputeShader");
-	Shader velocityFieldUpdateComputeShader("velocityFieldUpdate.ComputeShader");
-	Shader soilFlowComputeShader("soilFlow.ComputeShader");
-	Shader sedimentErosionAndDepositionComputeShader("sedimentErosionAndDeposition.ComputeShader");
-	Shader sedimentTransportationComputeShader("sedimentTransportation.ComputeShader");
-	Shader soilFlowDepositionComputeShader("soilFlowDeposition.ComputeShader");
-	Shader evaporationComputeShader("evaporation.ComputeShader");
-	Shader terrainRenderShader("terrainRender.vs", "terrainRender.fs");
-	Shader waterRenderShader("waterRender.vs", "waterRender.fs");
-	Shader swapBuffersComputeShader("swapBuffers.ComputeShader");
-
-	// set up vertex data (and buffer(s)) and configure vertex attributes
-	// ------------------------------------------------------------------
-	//Model ourModel("nanosuit/nanosuit.obj");
-
-	meshIndices = GenerateMeshIndices(MESH_WIDTH, MESH_HEIGHT);
-	meshVertices = GenerateMeshVertices(MESH_WIDTH, MESH_HEIGHT);
-	GenerateMeshTextures(MESH_WIDTH, MESH_HEIGHT);
-	
-	// Create mesh vertex array buffer
-	glGenVertexArrays(1, &meshVAO);
-	glGenBuffers(1, &meshVBO);
-	glGenBuffers(1, &meshEBO);
-
-	glBindVertexArray(meshVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
-
-	glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), &meshVertices[0], GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshIndices.size() * sizeof(unsigned int), &meshIndices[0], GL_STATIC_DRAW);
-
-	// vertex positions
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-	// vertex texture coords
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-
-	glBindVertexArray(0);	
-
-	// Create mesh vertex array buffer
-	glGenVertexArrays(1, &wMeshVAO);
-	glGenBuffers(1, &wMeshVBO);
-	glGenBuffers(1, &wMeshEBO);
-
-	glBindVertexArray(wMeshVAO);
-	glBindBuffer(GL_ARRAY_BUFFER, wMeshVBO);
-
-	glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), &meshVertices[0], GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, wMeshEBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshIndices.size() * sizeof(unsigned int), &meshIndices[0], GL_STATIC_DRAW);
-
-	// vertex positions
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-	// vertex texture coords
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-
-	glBindVertexArray(0);
-
-	// Set static shader settings
-	// water increment shader static properties
-	waterIncrementComputeShader.use();
-	waterIncrementComputeShader.setFloat("Km", Km);
-	waterIncrementComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
-	waterIncrementComputeShader.setFloat("timeStep", TIME_STEP);
-	// set source values
-	waterIncrementComputeShader.setInt("currentNumberSources", 2);
-	if (isSphereTerrain) {
-		// Source 1
-		waterIncrementComputeShader.setIVec2("sources[0].position", (int)(0.45f * MESH_WIDTH), (int)(0.45f * MESH_HEIGHT));
-		waterIncrementComputeShader.setInt("sources[0].radius", MESH_WIDTH / 80);
-		waterIncrementComputeShader.setFloat("sources[0].Kis", 0.3f);
-		// Source 2
-		waterIncrementComputeShader.setIVec2("sources[1].position", (int)(0.65f * MESH_WIDTH), (int)(0.65f * MESH_HEIGHT));
-		waterIncrementComputeShader.setInt("sources[1].radius", MESH_WIDTH / 80);
-		waterIncrementComputeShader.setFloat("sources[1].Kis", 0.3f);
-	}
-	else {
-		// Source 1
-		waterIncrementComputeShader.setIVec2("sources[0].position", (int)(0.25f * MESH_WIDTH), (int)(0.25f * MESH_HEIGHT));
-		waterIncrementComputeShader.setInt("sources[0].radius", MESH_WIDTH / 20);
-		waterIncrementComputeShader.setFloat("sources[0].Kis", 0.5f);
-		// Source 2
-		waterIncrementComputeShader.setIVec2("sources[1].position", (int)(0.75f * MESH_WIDTH), (int)(0.75f * MESH_HEIGHT));
-		waterIncrementComputeShader.setInt("sources[1].radius", MESH_WIDTH / 40);
-		waterIncrementComputeShader.setFloat("sources[1].Kis", 0.75f);
-	}
-	// set rain value
-	waterIncrementComputeShader.setInt("currentNumberRaindrops", numberOfRaindrops);
-	// Set source flow boolean
-	waterIncrementComputeShader.setBool("isSourceFlow", isSourceFlow);
-	// Set rain fall boolean
-	waterIncrementComputeShader.setBool("isRain", isRain);
-
-	// flux shader static properties
-	fluxUpdateComputeShader.use();
-	fluxUpdateComputeShader.setBool("isRegolith", isRegolith);
-	fluxUpdateComputeShader.setFloat("wKf", wKf);
-	fluxUpdateComputeShader.setFloat("rKf", rKf);
-	fluxUpdateComputeShader.setFloat("g", g);
-	fluxUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
-	fluxUpdateComputeShader.setFloat("pipeArea", PIPE_CROSS_SECTION_AREA);
-	fluxUpdateComputeShader.setFloat("width", MESH_WIDTH);
-	fluxUpdateComputeShader.setFloat("height", MESH_HEIGHT);
-	fluxUpdateComputeShader.setFloat("timeStep", TIME_STEP);
-
-	// height shader static properties
-	heightUpdateComputeShader.use();
-	heightUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
-	heightUpdateComputeShader.setFloat("width", MESH_WIDTH);
-	heightUpdateComputeShader.setFloat("height", MESH_HEIGHT);
-	heightUpdateComputeShader.setFloat("timeStep", TIME_STEP);
-
-	// velocity update static properties
-	velocityFieldUpdateComputeShader.use();
-	velocityFieldUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
-	velocityFieldUpdateComputeShader.setFloat("width", MESH_WIDTH);
-	velocityFieldUpdateComputeShader.setFloat("height", MESH_HEIGHT);
-
-	// soil flow shader static properties
-	soilFlowComputeShader.use();
-	soilFlowComputeShader.setBool("isSoilFlow", isSoilFlow);
-	soilFlowComputeShader.setFloat("terrainTalusAngle", terrainTalusAngle);
-	soilFlowComputeShader.setFloat("vegetationTalusAngle", vegetationTalusAngle);
-	soilFlowComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
-	soilFlowComputeShader.setFloat("Kt", Kt);
-	soilFlowComputeShader.setFloat("pipeLength", PIPE_LENGTH);
-	soilFlowComputeShader.setFloat("cellSeparation", 1.0f / MESH_WIDTH);
-	soilFlowComputeShader.setFloat("diagCellSeparation", 1.414213562373095f / MESH_WIDTH);
-	soilFlowComputeShader.setFloat("width", MESH_WIDTH);
-	soilFlowComputeShader.setFloat("height", MESH_HEIGHT);
-	soilFlowComputeShader.setFloat("timeStep", TIME_STEP);
-
-	// sediment erosion and deposition shader static properties
-	sedimentErosionAndDepositionComputeShader.use();
-	sedimentErosionAndDepositionComputeShader.setBool("isErosion", isErosion);
-	sedimentErosionAndDepositionComputeShader.setFloat("Kdmax", Kdmax);
-	sedimentErosionAndDepositionComputeShader.setFloat("Kc", Kc);
-	sedimentErosionAndDepositionComputeShader.setFloat("dissolvingConstant", Ks);
-	sedimentErosionAndDepositionComputeShader.setFloat("Kd", Kd);
-	sedimentErosionAndDepositionComputeShader.setFloat("width", MESH_WIDTH);
-	sedimentErosionAndDepositionComputeShader.setFloat("height", MESH_HEIGHT);
-	sedimentErosionAndDepositionComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
-
-	// sediment transportation shader static properties
-	sedimentTransportationComputeShader.use();
-	sedimentTransportationComputeShader.setFloat("width", MESH_WIDTH);
-	sedimentTransportationComputeShader.setFloat("height", MESH_HEIGHT);
-	sedimentTransportationComputeShader.setFloat("timeStep", TIME_STEP);
-
-	// soil deposition shader static properties
-	soilFlowDepositionComputeShader.use();
-	soilFlowDepositionComputeShader.setFloat("width", MESH_WIDTH);
-	soilFlowDepositionComputeShader.setFloat("height", MESH_HEIGHT);
-	soilFlowDepositionComputeShader.setFloat("pipeLength", PIPE_LENGTH);
-
-	// evaporation shader static properties
-	evaporationComputeShader.use();
-	evaporationComputeShader.setFloat("evaporationConstant", Ke);
-	evaporationComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
-	evaporationComputeShader.setFloat("timeStep", TIME_STEP);
-
-	// terrain render shader static properties
-	terrainRenderShader.use();
-	terrainRenderShader.setFloat("size", MESH_TOTAL_SIZE);
-	terrainRenderShader.setFloat("maxVegetationValue", maxVegetationValue);
-	terrainRenderShader.setFloat("terrainShininess", 1.0f);
-	terrainRenderShader.setFloat("waterShininess", 64.0f);
-	terrainRenderShader.setVec3("terrainColor", 0.87f, 0.85f, 0.6f);
-	terrainRenderShader.setVec3("vegetationColor", 0.31f, 0.5f, 0.1f);
-	terrainRenderShader.setVec3("deadVegetationColor", 0.6f, 0.4f, 0.2f);
-	terrainRenderShader.setVec3("terrainSpecularColor", 0.0f, 0.0f, 0.0f);
-	terrainRenderShader.setVec3("waterColor", 0.1f, 0.6f, 1.0f);
-	terrainRenderShader.setVec3("waterSpecularColor", 1.0f, 1.0f, 1.0f);
-	terrainRenderShader.setFloat("baseTerrainFrequency", baseTerrainFrequency);
-	terrainRenderShader.setFloat("baseTerrainAmplitude", baseTerrainAmplitude);
-	terrainRenderShader.setFloat("baseGrassFrequency", baseGrassFrequency);
-	terrainRenderShader.setFloat("baseGrassAmplitude", baseGrassAmplitude);
-	// set terrain render light properties
-	terrainRenderShader.setVec3("dirLight.direction", lightDirection);
-	terrainRenderShader.setVec3("dirLight.ambient", 0.4f, 0.4f, 0.4f);
-	terrainRenderShader.setVec3("dirLight.diffuse", 0.5f, 0.5f, 0.5f);
-	terrainRenderShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
-
-	// water render shader static properties
-	waterRenderShader.use();
-	waterRenderShader.setFloat("size", MESH_TOTAL_SIZE);
-	waterRenderShader.setFloat("terrainShininess", 1.0f);
-	waterRenderShader.setFloat("waterShininess", 64.0f);
-	waterRenderShader.setVec3("terrainColor", 0.87f, 0.85f, 0.6f);
-	waterRenderShader.setVec3("vegetationColor", 0.31f, 0.5f, 0.1f);
-	waterRenderShader.setVec3("terrainSpecularColor", 0.0f, 0.0f, 0.0f);
-	waterRenderShader.setVec3("waterColor", 0.1f, 0.6f, 1.0f);
-	waterRenderShader.setVec3("waterSpecularColor", 1.0f, 1.0f, 1.0f);
-	// set water render light properties
-	waterRenderShader.setVec3("dirLight.direction", lightDirection);
-	waterRenderShader.setVec3("dirLight.ambient", 0.4f, 0.4f, 0.4f);
-	waterRenderShader.setVec3("dirLight.diffuse", 0.5f, 0.5f, 0.5f);
-	waterRenderShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
-
-	float sourceFlowTime = 0;
-	float rainFallTime = 0;
-	float soilFlowTime = 0;
-
-	glm::mat4 projection;
-	glm::mat4 view;
-	glm::mat4 model;
-
-	glfwSetTime(0);
-	float currentFrame;
-	float cycleCount = 1;
-	float startTime;
-	float endTime;
-	float timeDifference;
-	float sumSimulationDifferences = 0;
-	float averageSimulationTime;
-	float sumRenderingDifferences = 0;
-	float averageRenderingTime;
-
-	// render loop
-	// -----------
-	while (!glfwWindowShouldClose(window))
-	{
-		// per-frame time logic
-		// --------------------
-		currentFrame = (float)glfwGetTime();
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;
-
-		//cout << 1 / deltaTime << endl;
-
-		// input
-		// -----
-		processInput(window);
-
-		startTime = (float)glfwGetTime();
-
-		// First Pass: Water Increment Step
-		waterIncrementComputeShader.use();
-		// Link tempCDTextureID to the output (binding = 0) of the water increment shader
-		glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempWTextureID to the output (binding = 1) of the water increment shader
-		glBindImageTexture(1, tempWTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 2 in water increment shader
-		glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link WTextureID to binding = 3 in water increment shader
-		glBindImageTexture(3, WTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Set Water Increment Shader Properties
-		if (isSourceFlow && sourceFlowTime < SOURCE_FLOW_CUTOFF_TIME) {
-			sourceFlowTime += deltaTime;
-		}
-		else if (isSourceFlow) {
-			isSourceFlow = false;
-			waterIncrementComputeShader.setBool("isSourceFlow", isSourceFlow);
-		}
-
-		if (isRain && rainFallTime < RAIN_CUTOFF_TIME) {
-			rainFallTime += deltaTime;
-			for (int i = 0; i < numberOfRaindrops; i++) {
-				string raindrop = "raindrops[";
-				raindrop += std::to_string(i);
-				string position = "].position";
-				string radius = "].radius";
-				string increment = "].Kir";
-
-				float Kir = (float)glm::linearRand(3, 5);
-
-				rainRadius = MESH_WIDTH / 100;
-
-				int x = glm::linearRand(rainRadius, (int)MESH_WIDTH - rainRadius);
-				int y = glm::linearRand(rainRadius, (int)MESH_HEIGHT - rainRadius);
-
-				waterIncrementComputeShader.setIVec2(raindrop + position, x, y);
-				waterIncrementComputeShader.setInt(raindrop + radius, rainRadius);
-				waterIncrementComputeShader.setFloat(raindrop + increment, Kir);
-			}
-		}
-		else if (isRain) {
-			isRain = false;
-			waterIncrementComputeShader.setBool("isRain", isRain);
-		}
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Second Pass: Flux(Water and Regolith) Update Step
-		fluxUpdateComputeShader.use();
-		// Link tempFTextureID to the output (binding = 0) in flux update shader
-		glBindImageTexture(0, tempFTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempRTextureID to the output (binding = 1) in flux update shader
-		glBindImageTexture(1, tempRTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 2 in flux update shader
-		glBindImageTexture(2, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempWTextureID to binding = 3 in flux update shader
-		glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link FTextureID to binding = 4 in flux update shader
-		glBindImageTexture(4, FTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link RTextureID to binding = 5 in flux update shader
-		glBindImageTexture(5, RTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Third Pass: Height (Water and Regolith) Update Step
-		heightUpdateComputeShader.use();
-		// Link CDTextureID to binding = 0 in water height update shader
-		glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 1 in water height update shader
-		glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempFTextureID to binding = 2 in water height update shader
-		glBindImageTexture(2, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempRTextureID to binding = 2 in water height update shader
-		glBindImageTexture(3, tempRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-	
-		// Sixth Pass: Velocity Field Update Step
-		velocityFieldUpdateComputeShader.use();
-		// Link tempVTextureID to binding = 0 in velocity field update shader
-		glBindImageTexture(0, tempVTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 1 in velocity field update shader
-		glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 2 in velocity field update shader
-		glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempFTextureID to binding = 3 in velocity field update shader
-		glBindImageTexture(3, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link VTextureID to binding = 4 in velocity field update shader
-		glBindImageTexture(4, VTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Sixth Pass: Soil Flow Step
-		soilFlowComputeShader.use();
-		// Link STextureID to binding = 0 in soil flow shader
-		glBindImageTexture(0, STextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link SCTextureID to binding = 1 in soil flow shader
-		glBindImageTexture(1, SCTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 2 in soil flow shader
-		glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempWTextureID to binding = 3 in soil flow shader
-		glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		if (soilFlowTime < SOIL_FLOW_CUTOFF_TIME) {
-			soilFlowTime += deltaTime;
-		}
-		else if (isSoilFlow) {
-			isSoilFlow = false;
-			soilFlowComputeShader.setBool("isSoilFlow", isSoilFlow);
-		}
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Seventh Pass: Sediment Erosion/Deposition Step
-		sedimentErosionAndDepositionComputeShader.use();
-		// Link tempCDTextureID to output (binding = 0) in sediment erosion/deposition shader
-		glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link WTextureID to output (binding = 1) in sediment erosion/deposition shader
-		glBindImageTexture(1, WTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 2 in sediment erosion/deposition shader
-		glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempWTextureID to binding = 3 in sediment erosion/deposition shader
-		glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempVTextureID to binding = 4 in sediment erosion/deposition shader
-		glBindImageTexture(4, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Eighth Pass: Sediment Transportation Step
-		sedimentTransportationComputeShader.use();
-		// Link tempWTextureID to binding = 0 in sediment transportation shader
-		glBindImageTexture(0, tempWTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link WTextureID to binding = 1 in sediment transportation shader
-		glBindImageTexture(1, WTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempVTextureID to binding = 2 in sediment transportation shader
-		glBindImageTexture(2, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Sixth Pass: Soil Flow Deposition Step
-		soilFlowDepositionComputeShader.use();
-		// Link CDTextureID to binding = 0 in soil flow deposition shader
-		glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 1 in soil flow deposition shader
-		glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link SCTextureID to binding = 2 in soil flow deposition shader
-		glBindImageTexture(2, STextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 3 in soil flow deposition shader
-		glBindImageTexture(3, SCTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Ninth Pass: Evaporation Step
-		evaporationComputeShader.use();
-		// Link tempCDTextureID to the output (binding = 0) of the evaporation shader
-		glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link CDTextureID to binding = 1 in the evaporation shader
-		glBindImageTexture(1, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		endTime = (float)glfwGetTime();
-		timeDifference = endTime - startTime;
-		sumSimulationDifferences += timeDifference;
-		averageSimulationTime = sumSimulationDifferences / cycleCount;
-
-		cout << "Sim Time: " << averageSimulationTime << endl;
-
-		// Final Pass: Terrain Render Step
-		// render
-		// ------
-		glClearColor(0.8f, 0.8f, 0.8f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		if (isMovieMode && isCameraMoving) {
-			if (isSquarePillarTerrain) {
-				if (glfwGetTime() > 120) {
-					float radius = 2.0f;
-					float speed = 0.1f;
-					float camX = sin((glfwGetTime() - 18) * speed) * radius;
-					float camZ = cos((glfwGetTime() - 18) * speed) * radius;
-
-					view = glm::lookAt(glm::vec3(camX, 1.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-				}
-				else {
-					view = camera.GetViewMatrix();
-				}
-			}
-			else {
-				float camX;
-				float camZ;
-				if (cameraChange == 0 && glfwGetTime() > 10) {
-					float radius = 3.0f;
-					float speed = 0.1f;
-					if (glfwGetTime() < 30) {
-						camX = sin((glfwGetTime() - 10) * speed) * radius;
-						camZ = cos((glfwGetTime() - 10) * speed) * radius;
-					}
-
-					view = glm::lookAt(glm::vec3(camX, 1.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-				}
-				else {
-					view = camera.GetViewMatrix();
-				}
-			}
-		}
-		else {
-			// camera/view transformation
-			view = camera.GetViewMatrix();
-		}
-
-		// projection matrix
-		projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-
-		model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(-(MESH_TOTAL_SIZE / 2.0f), 0.0f, -(MESH_TOTAL_SIZE / 2.0f)));
-
-		startTime = (float)glfwGetTime();
-
-		// activate terrain render shader
-		terrainRenderShader.use();
-		// set shader properties
-		terrainRenderShader.setVec3("viewPos", camera.Position);
-		terrainRenderShader.setInt("columnDataTexture", 0);
-		terrainRenderShader.setInt("waterDataTexture", 1);
-		
-		terrainRenderShader.setMat4("projection", projection);		
-		terrainRenderShader.setMat4("view", view);				
-		terrainRenderShader.setMat4("model", model);
-		
-		// bind texture
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, tempCDTextureID);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, tempWTextureID);
-
-		// render mesh
-		glBindVertexArray(meshVAO);
-		glDrawElements(GL_TRIANGLES, meshIndices.size(), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-
-		// activate water render shader
-		waterRenderShader.use();
-		// set shader properties
-		waterRenderShader.setVec3("viewPos", camera.Position);
-		waterRenderShader.setInt("columnDataTexture", 0);
-		waterRenderShader.setInt("waterDataTexture", 1);
-
-		waterRenderShader.setMat4("projection", projection);
-		waterRenderShader.setMat4("view", view);
-		waterRenderShader.setMat4("model", model);
-
-		// bind texture
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, tempCDTextureID);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, tempWTextureID);
-
-		// render mesh
-		glBindVertexArray(wMeshVAO);
-		glDrawElements(GL_TRIANGLES, meshIndices.size(), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-
-		endTime = (float)glfwGetTime();
-		timeDifference = endTime - startTime;
-		sumRenderingDifferences += timeDifference;
-		averageRenderingTime = sumRenderingDifferences / cycleCount;
-		cycleCount++;
-
-		cout << "Rend Time: " << averageRenderingTime << endl;
-
-		// Swap info in tempCDTexture to CDTexture
-		swapBuffersComputeShader.use();
-		// Link CDTextureID to the output (binding = 0) of the swap buffers shader
-		glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 1 in the swap buffers shader
-		glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-		
-
-		// Swap info in tempWTexture to WTexture
-		swapBuffersComputeShader.use();
-		// Link CDTextureID to the output (binding = 0) of the swap buffers shader
-		glBindImageTexture(0, WTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempCDTextureID to binding = 1 in the swap buffers shader
-		glBindImageTexture(1, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Swap info in tempFTexture to FTexture
-		swapBuffersComputeShader.use();
-		// Link FTextureID to the output (binding = 0) of the swap buffers shader
-		glBindImageTexture(0, FTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempFTextureID to binding = 1 in the swap buffers shader
-		glBindImageTexture(1, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Swap info in tempRTexture to RTexture
-		swapBuffersComputeShader.use();
-		// Link VTextureID to the output (binding = 0) of the swap buffers shader
-		glBindImageTexture(0, RTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempVTextureID to binding = 1 in the swap buffers shader
-		glBindImageTexture(1, tempRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		// Swap info in tempVTexture to VTexture
-		swapBuffersComputeShader.use();
-		// Link VTextureID to the output (binding = 0) of the swap buffers shader
-		glBindImageTexture(0, VTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
-		// Link tempVTextureID to binding = 1 in the swap buffers shader
-		glBindImageTexture(1, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
-		
-		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
-		// Prevent from moving on until all compute shader calculations are done
-		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);		
-
-		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(window);
-		glfwPollEvents();
-	}
-
-	// Deallocate all opengl resources
-	// -----------------------------------------------------------
-	glDeleteVertexArrays(1, &meshVAO);
-	glDeleteBuffers(1, &meshVBO);
-	glDeleteBuffers(1, &meshEBO);
-	glDeleteProgram(waterIncrementComputeShader.ID);
-	glDeleteProgram(fluxUpdateComputeShader.ID);
-	//glDeleteProgram(waterHeightUpdateComputeShader.ID);
-	glDeleteProgram(velocityFieldUpdateComputeShader.ID);
-	glDeleteProgram(soilFlowComputeShader.ID);
-	glDeleteProgram(sedimentErosionAndDepositionComputeShader.ID);
-	glDeleteProgram(sedimentTransportationComputeShader.ID);
-	glDeleteProgram(soilFlowDepositionComputeShader.ID);
-	glDeleteProgram(evaporationComputeShader.ID);
-	glDeleteProgram(terrainRenderShader.ID);
-	glDeleteProgram(swapBuffersComputeShader.ID);
-
-	// glfw: terminate, clearing all previously allocated GLFW resources.
-	// ------------------------------------------------------------------
-	glfwTerminate();
-	return 0;
-}
-
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-// ---------------------------------------------------------------------------------------------------------
-void processInput(GLFWwindow *window)
-{
-	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-		glfwSetWindowShouldClose(window, true);
-
-	if (!isMovieMode) {
-		if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-			camera.ProcessKeyboard(FORWARD, deltaTime);
-		}
-		if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-			camera.ProcessKeyboard(BACKWARD, deltaTime);
-		}
-		if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-			camera.ProcessKeyboard(LEFT, deltaTime);
-		}
-		if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-			camera.ProcessKeyboard(RIGHT, deltaTime);
-		}
-		if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS) {
-			float currentPressTime = (float)glfwGetTime();
-
-			if (currentPressTime - pLastPressTime > KEY_PRESS_DELAY) {
-				pLastPressTime = currentPressTime;
-				drawPolygon = !drawPolygon;
-				if (drawPolygon) {
-					glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-				}
-				else {
-					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-				}
-			}
-		}
-	}
-}
-
-// glfw: whenever the window size changed (by OS or user resize) this callback function executes
-// ---------------------------------------------------------------------------------------------
-void framebuffer_size_callback(GLFWwindow* window, int width, int height)
-{
-	// make sure the viewport matches the new window dimensions; note that width and 
-	// height will be significantly larger than specified on retina displays.
-	glViewport(0, 0, width, height);
-}
-
-
-// glfw: whenever the mouse moves, this callback is called
-// -------------------------------------------------------
-void mouse_callback(GLFWwindow* window, double xpos, double ypos)
-{
-	if (firstMouse)
-	{
-		lastX = (float)xpos;
-		lastY = (float)ypos;
-		firstMouse = false;
-	}
-
-	float xoffset = (float)xpos - lastX;
-	float yoffset = lastY - (float)ypos; // reversed since y-coordinates go from bottom to top
-
-	lastX = (float)xpos;
-	lastY = (float)ypos;
-
-	if (!isMovieMode) {
-		camera.ProcessMouseMovement(xoffset, yoffset);
-	}
-}
-
-// glfw: whenever the mouse scroll wheel scrolls, this callback is called
-// ----------------------------------------------------------------------
-void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
-{
-	if (!isMovieMode) {
-		camera.ProcessMouseScroll((float)yoffset);
-	}
-}
-
-vector<float> GenerateMeshVertices(unsigned int width, unsigned int height) {
-	vector<float> vertexList;
-	vertexList.reserve(5 * width * height);
-
-	// Generate vertex positions and texture coordinates
-	for (unsigned int j = 0; j < height; j++) {
-		for (unsigned int i = 0; i < width; i++) {
-			// vertex position
-			vertexList.push_back(i * MESH_SCALE);
-			vertexList.push_back(0);
-			vertexList.push_back(j * MESH_SCALE);
-
-			// vertex texture coordinate
-			vertexList.push_back((float)i / (width - 1));
-			vertexList.push_back((float)j / (height - 1));
-		}
-	}
-
-	return vertexList;
-}
-
-vector<unsigned int> GenerateMeshIndices(unsigned int width, unsigned int height) {
-	vector<unsigned int> indexList;
-	indexList.reserve(6 * width * height);
-	unsigned int index;
-
-	for (unsigned int j = 0; j < height - 1; j++) {
-		for (unsigned int i = 0; i < width - 1; i++) {
-			index = i + j * width;
-
-			// first triangle
-			indexList.push_back(index);
-			indexList.push_back(index + width);
-			indexList.push_back(index + 1);
-
-			// second triangle
-			indexList.push_back(index + width + 1);
-			indexList.push_back(index + 1);
-			indexList.push_back(index + width);
-		}
-	}
-
-	return indexList;
-}
-
-void GenerateMeshTextures(unsigned int width, unsigned int height) {
-	if(isSquarePillarTerrain){
-		GenerateSquarePillar(width, height);
-	}
-	else if (isSphereTerrain) {
-		GenerateSphere(width, height);
-	}
-	else {
-		GenerateBaseTextures(width, height);
-	}
-
-	// create texture for initial terrain data
-	glGenTextures(1, &CDTextureID);
-	glBindTexture(GL_TEXTURE_2D, CDTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &CDTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial water data
-	glGenTextures(1, &WTextureID);
-	glBindTexture(GL_TEXTURE_2D, WTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial flux
-	glGenTextures(1, &FTextureID);
-	glBindTexture(GL_TEXTURE_2D, FTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial velocity
-	glGenTextures(1, &VTextureID);
-	glBindTexture(GL_TEXTURE_2D, VTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial regolith flux
-	glGenTextures(1, &RTextureID);
-	glBindTexture(GL_TEXTURE_2D, RTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial sediment flux (Left, Right, Top, Bottom)
-	glGenTextures(1, &STextureID);
-	glBindTexture(GL_TEXTURE_2D, STextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for initial sediment corner flux (Bottom Left, Bottom Right, Top Left, Top Right)
-	glGenTextures(1, &SCTextureID);
-	glBindTexture(GL_TEXTURE_2D, SCTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, &EmptyTexture[0]);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for terrain data output
-	glGenTextures(1, &tempCDTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempCDTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for water data output
-	glGenTextures(1, &tempWTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempWTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for flux output
-	glGenTextures(1, &tempFTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempFTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for velocity output
-	glGenTextures(1, &tempVTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempVTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for regolith flux output
-	glGenTextures(1, &tempRTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempRTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for sediment flux output
-	glGenTextures(1, &tempSTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempSTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	// create texture for sediment corner flux output
-	glGenTextures(1, &tempSCTextureID);
-	glBindTexture(GL_TEXTURE_2D, tempSCTextureID);
-	glTexImage2D(GL_TEXTURE_2D, 0, INTERNAL_TEXTURE_FORMAT, MESH_WIDTH, MESH_HEIGHT, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-}
-
-void GenerateBaseTextures(unsigned int width, unsigned int height) {
-	unsigned int location;
-
-	FastNoise terrainNoise;
-	terrainNoise.SetNoiseType(FastNoise::Perlin);
-	terrainNoise.SetSeed(terrainSeed);
-
-	FastNoise vegetationNoise;
-	vegetationNoise.SetNoiseType(FastNoise::Perlin);
-	vegetationNoise.SetSeed(vegetationSeed);
-
-	for (unsigned int j = 0; j < height; j++) {
-		for (unsigned int i = 0; i < width; i++) {
-			location = GetLocation(i, j);
-
-			float iCoord = (float)i * 128 / MESH_WIDTH;
-			float jCoord = (float)j * 128 / MESH_HEIGHT;
-
-			float terrainFrequencyScale = 2;
-			float terrainNoiseValue = terrainNoise.GetNoise(terrainFrequencyScale * iCoord, terrainFrequencyScale * jCoord);
-			terrainNoiseValue += 0.5f * terrainNoise.GetNoise(terrainFrequencyScale * 2 * iCoord, terrainFrequencyScale * 2 * jCoord);
-			terrainNoiseValue += 0.25f * terrainNoise.GetNoise(terrainFrequencyScale * 4 * iCoord, terrainFrequencyScale * 4 * jCoord);
-			terrainNoiseValue += 0.125f * terrainNoise.GetNoise(terrainFrequencyScale * 8 * iCoord, terrainFrequencyScale * 8 * jCoord);
-
-			terrainNoiseValue /= HEIGHT_SCALING_VALUE;
-
-			float vegetationFrequencyScale = 4;
-			float vegetationNoiseValue = 0;
-			if (isVegetation) {
-				if (isVegetationSeed) {
-					vegetationNoiseValue += 3 * vegetationNoise.GetNoise(iCoord * vegetationFrequencyScale, jCoord * vegetationFrequencyScale);
-					vegetationNoiseValue += 1.5f * vegetationNoise.GetNoise(2 * iCoord * vegetationFrequencyScale, 2 * jCoord * vegetationFrequencyScale);
-					vegetationNoiseValue += 0.75f * vegetationNoise.GetNoise(4 * iCoord * vegetationFrequencyScale, 4 * jCoord * vegetationFrequencyScale);
-
-					vegetationNoiseValue = max(0.0f, vegetationNoiseValue);
-					vegetationNoiseValue /= HEIGHT_SCALING_VALUE;
-					vegetationNoiseValue = min(maxVegetationValue, vegetationNoiseValue);
-				}
-			}
-
-			//////////////////////////////
-			// Initial Column Data Texture (CDTexture)
-			//////////////////////////////
-			// R = water height value
-			// G = regolith height value
-			// B = vegetation height value
-			// A = terrain height value
-			//////////////////////////////
-			CDTexture[location + 0] = 0.0f; 
-			CDTexture[location + 1] = 0.0f; 
-			CDTexture[location + 2] = vegetationNoiseValue;
-			CDTexture[location + 3] = terrainNoiseValue - vegetationNoiseValue;
-		
-			////////////////////////////////////////////////////
-			// All of the textures below are initially empty (0)
-			////////////////////////////////////////////////////
-
-			//////////////////////////////
-			// Initial Water Data Texture (WTexture)
-			//////////////////////////////
-			// R = terrain sediment value
-			// G = dead vegetation sediment value
-			// B = time covered in water value
-			// A = dead vegetation height value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Flux Texture (FTexture)
-			//////////////////////////////
-			// R = left flux value
-			// G = right flux value
-			// B = top flux value
-			// A = bottom flux value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Velocity Texture (VTexture)
-			//////////////////////////////
-			// R = velocity in x-direction
-			// G = velocity in y-direction
-			// B = 
-			// A = 
-			//////////////////////////////
-			EmptyTexture[location + 0] = 0.0f; 
-			EmptyTexture[location + 1] = 0.0f; 
-			EmptyTexture[location + 2] = 0.0f; 
-			EmptyTexture[location + 3] = 0.0f; 
-		}
-	}
-
-	if (isVegetation) {
-		if (!isVegetationSeed) {
-			float vegetationValue;
-
-			float centerHeight;
-			float leftHeight;
-			float rightHeight;
-			float topHeight;
-			float bottomHeight;
-
-			float lrHeightDifference;
-			float tbHeightDifference;
-			float totalHeightDifference;
-
-			float MAX_HEIGHT_DIFFERENCE = (0.06f * 256.0f / MESH_WIDTH) / HEIGHT_SCALING_VALUE;
-
-			float percentage;
-
-			for (unsigned int j = 0; j < height; j++) {
-				for (unsigned int i = 0; i < width; i++) {
-					vegetationValue = maxVegetationValue;
-
-					location = GetLocation(i, j);
-					centerHeight = CDTexture[location + 3] + CDTexture[location + 2];
-					location = GetLocation(i - 1, j);
-					leftHeight = CDTexture[location + 3] + CDTexture[location + 2];
-					location = GetLocation(i + 1, j);
-					rightHeight = CDTexture[location + 3] + CDTexture[location + 2];
-					location = GetLocation(i, j + 1);
-					topHeight = CDTexture[location + 3] + CDTexture[location + 2];
-					location = GetLocation(i, j - 1);
-					bottomHeight = CDTexture[location + 3] + CDTexture[location + 2];
-
-					lrHeightDifference = abs(leftHeight - rightHeight);
-					tbHeightDifference = abs(topHeight - bottomHeight);
-
-					totalHeightDifference = lrHeightDifference + tbHeightDifference;
-
-					// 1D Height Texture for setting vegtation values
-					/*if (centerHeight < 0.1f / HEIGHT_SCALING_VALUE) {
-						CDTexture[location + 2] = vegetationValue;
-						CDTexture[location + 3] -= vegetationValue;
-					}*/
-
-					if (totalHeightDifference < MAX_HEIGHT_DIFFERENCE) {
-						percentage = min(1.0f, ((MAX_HEIGHT_DIFFERENCE - totalHeightDifference) / MAX_HEIGHT_DIFFERENCE) + 0.4f);
-						vegetationValue *= percentage;
-						CDTexture[location + 2] = vegetationValue;
-						CDTexture[location + 3] -= vegetationValue;
-					}
-				}
-			}
-		}
-	}
-}
-
-void GenerateSquarePillar(unsigned int width, unsigned int height) {
-	unsigned int location;
-	float terrainValue;
-	float vegetationValue;
-
-	for (unsigned int j = 0; j < height; j++) {
-		for (unsigned int i = 0; i < width; i++) {
-			location = GetLocation(i, j);
-			terrainValue = 0.0f;
-			vegetationValue = 0.0f;
-
-			if (i > width * 0.48f && i < width * 0.52f && j > height * 0.48f && j < height * 0.52f) {
-				if (isVegetation) {
-					vegetationValue = maxVegetationValue;
-				}
-				
-				terrainValue = 0.1f - vegetationValue;
-			}
-			else if (i > width * 0.42f && i < width * 0.46f && j > height * 0.54f && j < height * 0.58f) {
-				if (isVegetation) {
-					vegetationValue = maxVegetationValue;
-				}
-				
-				terrainValue = 0.1f - vegetationValue;
-			}
-			else if (i > width * 0.54f && i < width * 0.58f && j > height * 0.42f && j < height * 0.46f) {
-				if (isVegetation) {
-					vegetationValue = maxVegetationValue;
-				}
-				
-				terrainValue = 0.1f - vegetationValue;
-			}
-
-			//////////////////////////////
-			// Initial Column Data Texture (CDTexture)
-			//////////////////////////////
-			// R = water height value
-			// G = regolith height value
-			// B = vegetation height value
-			// A = terrain height value
-			//////////////////////////////
-			CDTexture[location + 0] = 0.0f;
-			CDTexture[location + 1] = 0.0f;
-			CDTexture[location + 2] = vegetationValue;
-			CDTexture[location + 3] = terrainValue;
-
-			////////////////////////////////////////////////////
-			// All of the textures below are initially empty (0)
-			////////////////////////////////////////////////////
-
-			//////////////////////////////
-			// Initial Water Data Texture (WTexture)
-			//////////////////////////////
-			// R = terrain sediment value
-			// G = dead vegetation sediment value
-			// B = time covered in water value
-			// A = dead vegetation height value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Flux Texture (FTexture)
-			//////////////////////////////
-			// R = left flux value
-			// G = right flux value
-			// B = top flux value
-			// A = bottom flux value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Velocity Texture (VTexture)
-			//////////////////////////////
-			// R = velocity in x-direction
-			// G = velocity in y-direction
-			// B = 
-			// A = 
-			//////////////////////////////
-			EmptyTexture[location + 0] = 0.0f;
-			EmptyTexture[location + 1] = 0.0f;
-			EmptyTexture[location + 2] = 0.0f;
-			EmptyTexture[location + 3] = 0.0f;
-		}
-	}
-}
-
-void GenerateSphere(unsigned int width, unsigned int height) {
-	unsigned int location;
-	float terrainValue;
-	float vegetationValue;
-	int centerX = width / 2;
-	int centerY = height / 2;
-	int cellRadius = width / 3;
-	float heightRadius = 0.1f;
-	int x;
-	int y;
-	float hypotenuse;
-
-	for (unsigned int j = 0; j < height; j++) {
-		for (unsigned int i = 0; i < width; i++) {
-			location = GetLocation(i, j);
-			terrainValue = 0.0f;
-			vegetationValue = 0.0f;
-
-			x = (i - centerX) * (i - centerX);
-			y = (j - centerY) * (j - centerY);
-			hypotenuse = x + y;
-
-			if (hypotenuse <= cellRadius * cellRadius) {
-				float percentage = sqrt(cellRadius * cellRadius - hypotenuse) / cellRadius;
-				if (isVegetation) {
-					vegetationValue = percentage * maxVegetationValue;
-				}
-				terrainValue = percentage * heightRadius - vegetationValue;
-			}
-
-			//////////////////////////////
-			// Initial Column Data Texture (CDTexture)
-			//////////////////////////////
-			// R = water height value
-			// G = regolith height value
-			// B = vegetation height value
-			// A = terrain height value
-			//////////////////////////////
-			CDTexture[location + 0] = 0.0f;
-			CDTexture[location + 1] = 0.0f;
-			CDTexture[location + 2] = vegetationValue;
-			CDTexture[location + 3] = terrainValue;
-
-			////////////////////////////////////////////////////
-			// All of the textures below are initially empty (0)
-			////////////////////////////////////////////////////
-
-			//////////////////////////////
-			// Initial Water Data Texture (WTexture)
-			//////////////////////////////
-			// R = terrain sediment value
-			// G = dead vegetation sediment value
-			// B = time covered in water value
-			// A = dead vegetation height value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Flux Texture (FTexture)
-			//////////////////////////////
-			// R = left flux value
-			// G = right flux value
-			// B = top flux value
-			// A = bottom flux value
-			//////////////////////////////
-			//////////////////////////////
-			// Initial Velocity Texture (VTexture)
-			//////////////////////////////
-			// R = velocity in x-direction
-			// G = velocity in y-direction
-			// B = 
-			// A = 
-			//////////////////////////////
-			EmptyTexture[location + 0] = 0.0f;
-			EmptyTexture[location + 1] = 0.0f;
-			EmptyTexture[location + 2] = 0.0f;
-			EmptyTexture[location + 3] = 0.0f;
-		}
-	}
-}
-
-unsigned int GetLocation(unsigned int i, unsigned int j) {
-	unsigned int x = i;
-	unsigned int y = j;
-
-	if (i < 0) {
-		x = 0;
-	}
-	else if (i >= MESH_WIDTH) {
-		x = MESH_WIDTH - 1;
-	}
-
-	if (j < 0) {
-		y = 0;
-	}
-	else if (j >= MESH_HEIGHT) {
-		y = MESH_HEIGHT - 1;
-	}
-
-	return (x + y * MESH_WIDTH) * 4;
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include "stb_image.h"
+#include "FastNoise.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/noise.hpp>
+#include <glm/gtc/random.hpp>
+#include <glm/gtx/normal.hpp>
+
+#include "shader.h"
+#include "camera.h"
+#include "tiledDomain.h"
+#include "stripDomain.h"
+#include "chunkedTerrain.h"
+#include "heightfieldRayMarcher.h"
+#include "cameraPath.h"
+#include "frameRecorder.h"
+#include "initialStateCache.h"
+#include "rasterImport.h"
+#include "rasterExport.h"
+#include "inputLog.h"
+#include "metricsReporter.h"
+
+#include <iostream>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+using namespace std;
+
+// GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile, which glad does not load
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void mouse_callback(GLFWwindow* window, double xpos, double ypos);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void processInput(GLFWwindow *window);
+bool IsKeyPressed(int key);
+void ApplyMouseMove(float xpos, float ypos);
+void ApplyScroll(float yoffset);
+void SetWaterSources(Shader &shader, unsigned int width, unsigned int height);
+void GenerateMeshTextures(unsigned int width, unsigned int height);
+void GenerateBaseTextures(unsigned int width, unsigned int height);
+void GenerateSquarePillar(unsigned int width, unsigned int height);
+void GenerateSphere(unsigned int width, unsigned int height);
+void GenerateTerrainOnGPU(unsigned int width, unsigned int height);
+void CoverVegetationOnGPU(unsigned int width, unsigned int height);
+bool ImportTerrain(unsigned int width, unsigned int height);
+void ExportState(unsigned int step);
+void GenerateActiveTileBuffers();
+void DispatchHydraulicPass();
+void GenerateMaxReductionBuffer();
+void GenerateRenderDataTexture(unsigned int width, unsigned int height);
+void GenerateDetailNoiseTexture(unsigned int size);
+void GenerateSceneFramebuffer(unsigned int width, unsigned int height);
+float ComputeStableTimeStep(float maxVelocity, float maxWaterDepth, float previousTimeStep);
+void GenerateCoarseTextures(unsigned int width, unsigned int height);
+unsigned int GenerateDataTexture(unsigned int width, unsigned int height, bool isCleared);
+void GenerateTiledDomainTextures(unsigned int width, unsigned int height);
+bool GenerateTiledDomainTerrain(TiledDomain &domain);
+void GenerateStripTextures(unsigned int firstRow, unsigned int height);
+void BaseTerrainNoiseSet(FastNoise &terrainNoise, const vector<float> &iCoords, const vector<float> &jCoords, float *noiseSet);
+void BaseVegetationNoiseSet(FastNoise &vegetationNoise, const vector<float> &iCoords, const vector<float> &jCoords, float *noiseSet);
+void OctaveNoiseSet(FastNoise &noise, const vector<float> &iCoords, const vector<float> &jCoords, float frequencyScale, const float *octaveAmplitudes, unsigned int octaves, float *noiseSet);
+unsigned int GetLocation(unsigned int i, unsigned int j);
+void ParallelForRows(unsigned int rows, const function<void(unsigned int, unsigned int)> &body);
+
+// window settings
+const unsigned int SCR_WIDTH = 1980;
+const unsigned int SCR_HEIGHT = 1018;
+
+// timing
+float deltaTime = 0.0f;	// time between current frame and last frame
+float lastFrame = 0.0f;
+
+// mesh settings
+const unsigned int MESH_WIDTH = 1024;
+const unsigned int MESH_HEIGHT = MESH_WIDTH;
+const unsigned int MESH_TOTAL_SIZE = 5;
+const float MESH_SCALE = (float)MESH_TOTAL_SIZE / (float)MESH_WIDTH;
+
+// mesh level of detail settings
+// The terrain and water are drawn as CDLOD patches, at the coarsest level whose vertex spacing shows as at most LOD_PIXEL_ERROR pixels
+const unsigned int LOD_PATCH_RESOLUTION = 16; // Quads along a patch edge, must be even
+const float LOD_PIXEL_ERROR = 4.0f;
+const float LOD_HEIGHT_BOUND = 0.3f * MESH_TOTAL_SIZE; // Bound on the rendered heights, for the distance from the eye to a patch
+
+// Ray march the terrain and water heightfields in a full screen pass instead of drawing the level of detail patches, whose cost
+// follows the pixels rather than the cells, for grids too large to draw as triangles, see HeightfieldRayMarcher
+const bool isRayMarchedRender = false;
+
+// camera
+// Camera above the middle of the map
+//Camera camera(glm::vec3(0.0f, 1.5f * MESH_TOTAL_SIZE, 0.0f));
+
+// Camera just above the ground, focusing on distinction between vegetated and non-vegetated erosion
+//Camera camera(glm::vec3(-1.0f * MESH_TOTAL_SIZE / 2.0f, 0.02f * MESH_TOTAL_SIZE, -1.1f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 50, -15);
+//Camera camera(glm::vec3(-0.43f * MESH_TOTAL_SIZE / 2.0f, 0.003f * MESH_TOTAL_SIZE, -0.37f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 75, -15);
+
+// Camera zoomed in on three pillars
+//Camera camera(glm::vec3(-0.6f * MESH_TOTAL_SIZE / 2.0f, 0.3f * MESH_TOTAL_SIZE, -0.6f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -35);
+
+// Camera zoomed in on entire terrain
+//Camera camera(glm::vec3(-1.5f * MESH_TOTAL_SIZE / 2.0f, 1.3f * MESH_TOTAL_SIZE, -1.5f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -55);
+
+// Camera focused on entire terrain focusing on a single edge
+Camera camera(glm::vec3(-1.8f * MESH_TOTAL_SIZE / 2.0f, 0.8f * MESH_TOTAL_SIZE, 0.0f), glm::vec3(0, 1, 0), 0, -45);
+
+// Camera zoomed-in on sphere terrain source flow
+//Camera camera(glm::vec3(-0.8f * MESH_TOTAL_SIZE / 2.0f, 0.3f * MESH_TOTAL_SIZE, -0.8f * MESH_TOTAL_SIZE / 2.0f), glm::vec3(0, 1, 0), 45, -35);
+
+float lastX = SCR_WIDTH / 2.0f;
+float lastY = SCR_HEIGHT / 2.0f;
+bool firstMouse = true;
+int cameraChange = 0;
+
+// texture settings
+const float HEIGHT_SCALING_VALUE = 10.0f;
+vector<float> CDTexture;
+unsigned int CDTextureID, WTextureID, FTextureID, VTextureID, RTextureID, STextureID, SCTextureID;
+unsigned int tempCDTextureID, tempWTextureID, tempFTextureID, tempVTextureID, tempRTextureID, tempSTextureID, tempSCTextureID;
+unsigned int coarseCDTextureID, coarseWTextureID, coarseFTextureID, coarseRTextureID;
+unsigned int tempCoarseCDTextureID, tempCoarseWTextureID, tempCoarseFTextureID, tempCoarseRTextureID;
+unsigned int renderCDTextureID, renderWTextureID;
+unsigned int renderDataTextureID;
+unsigned int detailNoiseTextureID;
+unsigned int sceneFramebufferID, sceneColorRenderbufferID, sceneDepthRenderbufferID;
+
+// texture settings
+const GLenum TEXTURE_FORMAT = GL_RGBA;
+const GLenum INTERNAL_TEXTURE_FORMAT = GL_RGBA32F;
+
+// compute shader settings
+const unsigned int WORK_GROUP_SIZE_X = 32;
+const unsigned int WORK_GROUP_SIZE_Y = 32;
+const unsigned int WORK_GROUP_SIZE_Z = MESH_WIDTH; // Must be kept as MESH_WIDTh so that the number of groups in z remains 1
+const unsigned int NUM_GROUPS_X = MESH_WIDTH / WORK_GROUP_SIZE_X;
+const unsigned int NUM_GROUPS_Y = MESH_WIDTH / WORK_GROUP_SIZE_Y;
+const unsigned int NUM_GROUPS_Z = MESH_WIDTH / WORK_GROUP_SIZE_Z;
+// Work groups covering the simulated textures, which only hold the current tile region of a tiled domain
+GLuint simulationGroupsX = NUM_GROUPS_X;
+GLuint simulationGroupsY = NUM_GROUPS_Y;
+
+// active tile settings
+// A tile is one 32x32 work group, so the tile grid matches the compute dispatch grid
+const unsigned int NUM_TILES_X = NUM_GROUPS_X;
+const unsigned int NUM_TILES_Y = NUM_GROUPS_Y;
+const unsigned int TILE_COMPACTION_GROUP_SIZE = 8;
+unsigned int tileActivityBufferID, activeTilesBufferID;
+
+// max reduction settings
+unsigned int maxReductionBufferID;
+GLsync maxReductionFence = 0;
+
+// debug settings
+bool drawPolygon = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////  Main Simulation Settings  //////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Lighting Settings
+glm::vec3 lightDirection(-1.0, -1.0, -1.0);
+
+// Movie Mode Setting
+bool isMovieMode = false;
+bool isCameraMoving = false;
+
+// Vegetation Boolean Values
+bool isVegetation = true;
+bool isVegetationSeed = false;
+
+// Terrain Generation Settings
+const int terrainSeed = 8675309; //4120412;
+const int vegetationSeed = 1337;
+float maxVegetationValue = 0.0035f;
+const bool isSquarePillarTerrain = false;
+const bool isSphereTerrain = false;
+// Generate the terrain scenarios with compute shaders straight into the column data texture, instead of on the host
+const bool isGPUTerrainGeneration = true;
+// Keep every generated initial column data texture in INITIAL_STATE_CACHE_DIRECTORY, which must exist, and upload it
+// instead of generating it again when a run has the same scenario parameters, see InitialStateKey
+const bool isInitialStateCached = false;
+const char *INITIAL_STATE_CACHE_DIRECTORY = "initialStateCache";
+const unsigned int INITIAL_STATE_CACHE_VERSION = 1; // Bump when a terrain generator changes, so its older states are not used
+
+// Terrain Import Settings
+// Start from an elevation raster instead of a generated scenario, see RasterReader for the formats. The raster is streamed
+// row by row and resampled to the grid, terrain heights are DEM_HEIGHT_SCALE * elevation + DEM_HEIGHT_OFFSET
+const bool isImportedTerrain = false;
+const char *DEM_PATH = "dem.tif";
+const RasterSampleType DEM_RAW_SAMPLE_TYPE = RASTER_INT16; // Raw grids only, as the size below
+const unsigned int DEM_RAW_WIDTH = 4096;
+const unsigned int DEM_RAW_HEIGHT = 4096;
+const float DEM_HEIGHT_SCALE = 0.0001f;
+const float DEM_HEIGHT_OFFSET = -0.05f;
+const float DEM_NO_DATA_VALUE = -32768.0f;
+// Optional land cover raster over the extent of the elevation raster whose classes set the vegetation, a raw land cover grid has
+// the size of the raw elevation grid. Without one the flat ground is covered in vegetation as on the generated terrain
+const char *LAND_COVER_PATH = "";
+const RasterSampleType LAND_COVER_RAW_SAMPLE_TYPE = RASTER_UINT8;
+// Share of maxVegetationValue on every vegetated class, ESA WorldCover tree cover, shrubland, grassland and cropland
+const LandCoverVegetation LAND_COVER_VEGETATION[] = { { 10, 1.0f }, { 20, 0.7f }, { 30, 0.5f }, { 40, 0.3f } };
+
+// State Export Settings
+// Pressing E writes the column data and water textures as they are rendered to files named STATE_EXPORT_PREFIX, the simulation
+// step and the texture, see RasterExporter for the formats. A tiled domain exports its preview
+const RasterExportFormat STATE_EXPORT_FORMAT = EXPORT_HALF_EXR;
+const char *STATE_EXPORT_PREFIX = "state";
+const bool isStateExportedOnExit = false;
+
+// Shader Program Settings
+// Keep the linked binary of every program in SHADER_CACHE_DIRECTORY, which must exist, and load it instead of compiling the
+// program again while the driver and the sources stay the same, see Shader
+const bool isShaderProgramCached = false;
+const char *SHADER_CACHE_DIRECTORY = "shaderCache";
+
+// Input Recording Settings
+// Record the time of every frame, the keys processInput polls and the mouse and scroll events to INPUT_LOG_PATH, or play a
+// recorded log back in place of the live input, which runs the session again frame for frame and ends with the log. A replayed
+// frame that starts at another simulation step or time step than the recorded one reports the replay diverged, once
+const bool isInputRecorded = false;
+const bool isInputReplayed = false;
+const char *INPUT_LOG_PATH = "input.log";
+
+// Metrics Settings
+// The render loop records the steps, time steps, max reductions and host times of every frame, which a reporter thread
+// writes out as one line of aggregates every METRICS_REPORT_INTERVAL seconds, to METRICS_PATH or standard output when it is
+// empty. The processes of a multi-process run after the first write to METRICS_PATH followed by their rank
+const MetricsFormat METRICS_FORMAT = METRICS_CSV;
+const float METRICS_REPORT_INTERVAL = 1.0f;
+const char *METRICS_PATH = "";
+
+// Terrain Rendering Fragment Shader Values
+// The detail noise is baked once into a DETAIL_NOISE_TEXTURE_SIZE texture over the terrain, which must resolve its finest octave
+const float baseTerrainAmplitude = 0.1f;
+const float baseTerrainFrequency = 10.0f;
+const float baseGrassAmplitude = 0.1f;
+const float baseGrassFrequency = 5.0f;
+const unsigned int DETAIL_NOISE_TEXTURE_SIZE = 2048;
+
+// Boolean Settings For Erosion Effects
+bool isSourceFlow = true;
+bool isRain = true;
+bool isErosion = true;
+bool isRegolith = true;
+bool isSoilFlow = true;
+
+// Tiled Domain Settings
+// Simulates a TILED_DOMAIN_WIDTH x TILED_DOMAIN_HEIGHT domain too large for the GPU. Its tiles are kept in host memory
+// (or on disk) and streamed through the GPU each step with a DOMAIN_TILE_HALO band from their neighbors' last step.
+// Cells keep the size of a MESH_WIDTH grid, which only renders a downsampled preview of the domain
+const bool isTiledDomain = false;
+const bool isTiledDomainOnDisk = false; // Keep the tiles in files under TILED_DOMAIN_DIRECTORY, which must exist
+const char *TILED_DOMAIN_DIRECTORY = "tiledDomain";
+const unsigned int TILED_DOMAIN_WIDTH = 16384; // Must be a multiple of WORK_GROUP_SIZE_X
+const unsigned int TILED_DOMAIN_HEIGHT = TILED_DOMAIN_WIDTH;
+const unsigned int DOMAIN_TILE_SIZE = 1024; // Must be a multiple of WORK_GROUP_SIZE_X
+// Must be a multiple of WORK_GROUP_SIZE_X and cover the reach of one step
+const unsigned int DOMAIN_TILE_HALO = 32;
+// Cells sediment is traced back in a step at most, in every mode so a tiled domain steps like a single grid. The five passes
+// before the sediment transport and the one after it each leave a cell of the halo band stale, and the interpolation reads one more
+const float MAX_SEDIMENT_BACKTRACE = DOMAIN_TILE_HALO - 8.0f;
+const unsigned int SIMULATION_WIDTH = isTiledDomain ? TILED_DOMAIN_WIDTH : MESH_WIDTH;
+const unsigned int SIMULATION_HEIGHT = isTiledDomain ? TILED_DOMAIN_HEIGHT : MESH_HEIGHT;
+
+// Multi-Process Settings
+// Splits the grid into NUMBER_OF_PROCESSES strips of rows, each simulated by its own process on this machine. The first
+// process launches the others and renders the gathered grid, neighbors exchange PROCESS_HALO rows through shared memory.
+// Not available together with a tiled domain
+const bool isMultiProcess = false;
+const unsigned int NUMBER_OF_PROCESSES = 2; // Every strip must hold at least PROCESS_HALO rows
+// Sediment carried further than the halo in one step is cut off at the strip border
+const unsigned int PROCESS_HALO = 2;
+const char *SHARED_MEMORY_NAME = "OpenGLWaterSimulation";
+
+// Active Tile Scheduling Setting
+// Hydraulic passes only run on tiles (plus a one tile border) that hold water, sediment or flux
+// Not available for a tiled domain, whose textures change tile region every few passes, or the strips of a multi-process grid
+const bool isActiveTileScheduling = !isTiledDomain && !isMultiProcess;
+
+// Water Increment Source and Rain settings
+// The cutoffs are in simulated time, the 15 seconds they were tuned at took 900 steps of TIME_STEP at 60 frames per second
+const float SOURCE_FLOW_CUTOFF_TIME = 1.8f;
+const float RAIN_CUTOFF_TIME = 1.8f;
+const float Km = 0.00005f; // Regolith Max Height Constant
+int numberOfRaindrops = 1;
+int rainRadius;
+
+// Flux Update Settings
+const float wKf = 0.999f; // Water Friction Coefficient
+const float rKf = 0.3f; // Regolith Frition Coefficient
+const float g = 9.81f; // Gravity Coefficient
+
+// Soil Flow Settings
+const float Kt = 100.0f;
+const float terrainTalusAngle = 35.0f;
+const float vegetationTalusAngle = 50.0f;
+const float SOIL_FLOW_CUTOFF_TIME = 5400.0f; // In simulated time, see SOURCE_FLOW_CUTOFF_TIME
+
+// Sediment Erosion and Deposition Settings
+const float Kdmax = 0.007f; // Max Erosion Ramp Constant
+const float Kc = 0.0004f; // Sediment Capacity Constant
+const float Ks = 0.00003f; // Dissolving Constant
+const float Kd = 0.00003f; // Deposition Constant
+
+// Evaporation Settings
+const float Ke = 3; // Evaporation Constant
+
+// Simulation Settings
+const float TIME_STEP = min(0.002f, 0.002f * (256.0f / MESH_WIDTH));
+const float PIPE_LENGTH = 256.0f / MESH_WIDTH;
+const float PIPE_CROSS_SECTION_AREA = 20 * PIPE_LENGTH;
+
+// Adaptive Time Step Settings
+// The time step follows a CFL condition on the max water velocity and depth, reduced on the GPU
+// CFL_NUMBER is the max number of pipes the flow may cross per step. Outflow is scaled back to the water
+// available in a column, which keeps the pipe model stable past 1, and storm-peak flows at 4 match the fixed TIME_STEP
+// Erosion and deposition are scaled by the time step relative to TIME_STEP, and soil flow moves Kt * timeStep of half the
+// steepest height difference in a step, which overshoots past 1 / Kt, so the time step never grows past that either
+const bool isAdaptiveTimeStep = true;
+const float CFL_NUMBER = 4.0f;
+const float CFL_MIN_WATER_DEPTH = 0.0005f; // Thinner water films are left out of the max velocity
+const float MIN_TIME_STEP = 0.25f * TIME_STEP;
+const float MAX_TIME_STEP = min(4.0f * TIME_STEP, 1.0f / Kt);
+const float MAX_TIME_STEP_GROWTH = 1.2f; // Max increase of the time step per update
+const unsigned int TIME_STEP_REDUCTION_INTERVAL = 4; // Simulation steps between max velocity/depth reductions
+float timeStep = TIME_STEP;
+float simulationTime = 0;
+unsigned int simulationStep = 0;
+
+// Simulation And Render Rate Settings
+// Every rendered frame runs simulationStepsPerFrame simulation steps, so batch runs that only
+// need an occasional frame can raise it to render once every k steps
+int simulationStepsPerFrame = 1;
+const bool isFrameTimeBudget = false; // Adapt simulationStepsPerFrame to hold TARGET_FRAME_TIME
+const float TARGET_FRAME_TIME = 1.0f / 30.0f;
+const int MAX_SIMULATION_STEPS_PER_FRAME = 256;
+
+// Dynamic Render Resolution Settings
+// The terrain and water are drawn to a scene framebuffer at renderScale times the window size and upscaled to the window.
+// The scale follows TARGET_FRAME_TIME ahead of simulationStepsPerFrame, so a frame over budget gives up pixels before steps
+const bool isDynamicRenderResolution = false;
+const float MIN_RENDER_SCALE = 0.5f;
+const float MAX_RENDER_SCALE = 1.0f;
+const float RENDER_SCALE_STEP = 0.05f; // Change of the scale per frame
+float renderScale = MAX_RENDER_SCALE;
+
+// Offline Flythrough Settings
+// Records a video in a hidden window, one frame after every simulationStepsPerFrame steps, with the camera flown along
+// FLYTHROUGH_PATH by simulation time until its last keyframe. Frames are drawn to an offscreen FLYTHROUGH_WIDTH x FLYTHROUGH_HEIGHT
+// framebuffer, read back through FLYTHROUGH_PIXEL_BUFFERS pixel buffers and piped as raw RGB to FLYTHROUGH_ENCODER_COMMAND,
+// or written as PPM files named by FLYTHROUGH_FRAME_PATTERN without one. The cutoffs run on simulated time and the adaptive time
+// step only changes on the steps that read back a max reduction, so the video is the same however long the frames take to compute
+const bool isOfflineFlythrough = false;
+const unsigned int FLYTHROUGH_WIDTH = 1920;
+const unsigned int FLYTHROUGH_HEIGHT = 1080;
+const float FLYTHROUGH_FRAME_RATE = 30.0f;
+const unsigned int FLYTHROUGH_PIXEL_BUFFERS = 3;
+const char *FLYTHROUGH_ENCODER_COMMAND = ""; // e.g. "ffmpeg -y -f rawvideo -pixel_format rgb24 -video_size 1920x1080 -framerate 30 -i - -c:v libx264 -pix_fmt yuv420p flythrough.mp4"
+const char *FLYTHROUGH_FRAME_PATTERN = "flythrough_%05d.ppm";
+const float FLYTHROUGH_DURATION = 3000 * TIME_STEP;
+// Around the terrain from the edge view, then down to a low pass over its middle
+const CameraKeyframe FLYTHROUGH_PATH[] = {
+	{ 0.0f * FLYTHROUGH_DURATION, glm::vec3(-1.8f * MESH_TOTAL_SIZE / 2.0f, 0.8f * MESH_TOTAL_SIZE, 0.0f), 0.0f, -45.0f },
+	{ 0.3f * FLYTHROUGH_DURATION, glm::vec3(-1.3f * MESH_TOTAL_SIZE / 2.0f, 0.6f * MESH_TOTAL_SIZE, -1.3f * MESH_TOTAL_SIZE / 2.0f), 45.0f, -35.0f },
+	{ 0.6f * FLYTHROUGH_DURATION, glm::vec3(0.0f, 0.5f * MESH_TOTAL_SIZE, -1.8f * MESH_TOTAL_SIZE / 2.0f), 90.0f, -30.0f },
+	{ 0.8f * FLYTHROUGH_DURATION, glm::vec3(0.2f * MESH_TOTAL_SIZE / 2.0f, 0.1f * MESH_TOTAL_SIZE, -0.8f * MESH_TOTAL_SIZE / 2.0f), 100.0f, -20.0f },
+	{ 1.0f * FLYTHROUGH_DURATION, glm::vec3(0.3f * MESH_TOTAL_SIZE / 2.0f, 0.05f * MESH_TOTAL_SIZE, 0.2f * MESH_TOTAL_SIZE / 2.0f), 110.0f, -15.0f }
+};
+
+// Coarse Water Spin Up Settings
+// Before erosion starts, source flow runs for COARSE_SPIN_UP_STEPS steps on a grid COARSE_GRID_FACTOR
+// times coarser until the water has spread, and the water surface is then prolonged to the full grid
+const bool isCoarseWaterSpinUp = false;
+const unsigned int COARSE_GRID_FACTOR = 4;
+const unsigned int COARSE_MESH_WIDTH = MESH_WIDTH / COARSE_GRID_FACTOR; // Must stay a multiple of WORK_GROUP_SIZE_X
+const unsigned int COARSE_MESH_HEIGHT = MESH_HEIGHT / COARSE_GRID_FACTOR;
+const unsigned int COARSE_SPIN_UP_STEPS = 2000;
+const float COARSE_TIME_STEP = min(0.002f, 0.002f * (256.0f / COARSE_MESH_WIDTH));
+const float COARSE_PIPE_LENGTH = 256.0f / COARSE_MESH_WIDTH;
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Key Press Settings
+const float KEY_PRESS_DELAY = 1.0f;
+float pLastPressTime = 0;
+float spaceLastPressTime = 0;
+bool isSimulationPaused = false; // Toggled with space, a paused simulation keeps rendering its last state
+float eLastPressTime = 0;
+bool isStateExportRequested = false; // Set with E, the state is exported once the frame's simulation steps have run
+// Keys processInput polls, in the order of their bits in InputFrame::Keys
+const int INPUT_KEYS[] = { GLFW_KEY_ESCAPE, GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D, GLFW_KEY_SPACE, GLFW_KEY_P, GLFW_KEY_E };
+InputLog inputLog;
+InputFrame inputFrame; // The callbacks queue the mouse and scroll events here until processInput applies them
+bool isReplayDiverged = false;
+
+int main(int argc, char *argv[])
+{
+	// The first process of a multi-process run launches the others with their rank as the only argument
+	unsigned int processRank = isMultiProcess && argc > 1 ? (unsigned int)atoi(argv[1]) : 0;
+
+	// glfw: initialize and configure
+	// ------------------------------
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // uncomment this statement to fix compilation on OS X
+#endif
+
+	// glfw window creation
+	// --------------------
+	// Only the first process of a multi-process run shows its window, and an offline flythrough shows none
+	if (processRank > 0 || isOfflineFlythrough) {
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
+	GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "OpenGLWaterSimulation", NULL, NULL);
+	if (processRank == 0 && !isOfflineFlythrough) {
+		glfwMaximizeWindow(window);
+	}
+
+	if (window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+	glfwSetCursorPosCallback(window, mouse_callback);
+	glfwSetScrollCallback(window, scroll_callback);
+
+	// tell GLFW to capture our mouse
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// glad: load all OpenGL function pointers
+	// ---------------------------------------
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cout << "Failed to initialize GLAD" << std::endl;
+		return -1;
+	}
+
+	// configure global opengl state
+	// -----------------------------
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// Let the driver compile and link the programs below on its own threads, the errors of each are checked when it is first used
+	const char *compilerThreadsFunction = glfwExtensionSupported("GL_KHR_parallel_shader_compile") ? "glMaxShaderCompilerThreadsKHR" :
+		glfwExtensionSupported("GL_ARB_parallel_shader_compile") ? "glMaxShaderCompilerThreadsARB" : NULL;
+	if (compilerThreadsFunction != NULL) {
+		PFNGLMAXSHADERCOMPILERTHREADSPROC glMaxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)glfwGetProcAddress(compilerThreadsFunction);
+		glMaxShaderCompilerThreads(0xFFFFFFFF);
+	}
+	if (isShaderProgramCached) {
+		Shader::CacheDirectory() = SHADER_CACHE_DIRECTORY;
+	}
+
+	// build and compile our shader zprogram
+	// ------------------------------------
+	Shader waterIncrementComputeShader("waterIncrement.ComputeShader");
+	Shader fluxUpdateComputeShader("fluxUpdate.ComputeShader");
+	Shader heightUpdateComputeShader("heightUpdate.ComputeShader");
+	Shader velocityFieldUpdateComputeShader("velocityFieldUpdate.ComputeShader");
+	Shader soilFlowComputeShader("soilFlow.ComputeShader");
+	Shader sedimentErosionAndDepositionComputeShader("sedimentErosionAndDeposition.ComputeShader");
+	Shader sedimentTransportationComputeShader("sedimentTransportation.ComputeShader");
+	Shader soilFlowDepositionComputeShader("soilFlowDeposition.ComputeShader");
+	Shader evaporationComputeShader("evaporation.ComputeShader");
+	Shader terrainRenderShader("terrainRender.vs", "terrainRender.fs");
+	Shader waterRenderShader("waterRender.vs", "waterRender.fs");
+	Shader swapBuffersComputeShader("swapBuffers.ComputeShader");
+	Shader tileActivityComputeShader("tileActivity.ComputeShader");
+	Shader tileCompactionComputeShader("tileCompaction.ComputeShader");
+	Shader maxReductionComputeShader("maxReduction.ComputeShader");
+	Shader heightBoundsComputeShader("heightBounds.ComputeShader");
+	Shader heightBoundsReductionComputeShader("heightBoundsReduction.ComputeShader");
+	Shader patchCullingComputeShader("patchCulling.ComputeShader");
+	Shader renderPrepComputeShader("renderPrep.ComputeShader");
+	Shader rayMarchMaxHeightComputeShader("rayMarchMaxHeight.ComputeShader");
+	Shader rayMarchMaxHeightReductionComputeShader("rayMarchMaxHeightReduction.ComputeShader");
+	Shader heightfieldRayMarchShader("heightfieldRayMarch.vs", "heightfieldRayMarch.fs");
+
+	TiledDomain tiledDomain(TILED_DOMAIN_WIDTH, TILED_DOMAIN_HEIGHT, DOMAIN_TILE_SIZE, DOMAIN_TILE_HALO, MESH_WIDTH, MESH_HEIGHT, isTiledDomainOnDisk ? TILED_DOMAIN_DIRECTORY : "");
+
+	StripDomain stripDomain(MESH_WIDTH, MESH_HEIGHT, PROCESS_HALO);
+	if (isMultiProcess && !stripDomain.Initialize(SHARED_MEMORY_NAME, processRank, NUMBER_OF_PROCESSES, argv[0])) {
+		glfwTerminate();
+		return -1;
+	}
+
+	// set up vertex data (and buffer(s)) and configure vertex attributes
+	// ------------------------------------------------------------------
+	//Model ourModel("nanosuit/nanosuit.obj");
+
+	GenerateMeshTextures(MESH_WIDTH, MESH_HEIGHT);
+	GenerateActiveTileBuffers();
+	GenerateMaxReductionBuffer();
+	GenerateRenderDataTexture(MESH_WIDTH, MESH_HEIGHT);
+	GenerateDetailNoiseTexture(DETAIL_NOISE_TEXTURE_SIZE);
+	if (isDynamicRenderResolution) {
+		GenerateSceneFramebuffer(SCR_WIDTH, SCR_HEIGHT);
+	}
+
+	// An offline flythrough records its frames from its own framebuffer
+	CameraPath flythroughPath(FLYTHROUGH_PATH, sizeof(FLYTHROUGH_PATH) / sizeof(FLYTHROUGH_PATH[0]));
+	FrameRecorder frameRecorder(FLYTHROUGH_WIDTH, FLYTHROUGH_HEIGHT, FLYTHROUGH_PIXEL_BUFFERS);
+	if (isOfflineFlythrough && processRank == 0) {
+		if (!frameRecorder.Open(FLYTHROUGH_ENCODER_COMMAND, FLYTHROUGH_FRAME_PATTERN)) {
+			glfwTerminate();
+			return -1;
+		}
+		frameRecorder.Generate();
+	}
+
+	// The first process polls the input of a multi-process run, the others take the frame time it shares
+	if (processRank == 0 && (isInputRecorded || isInputReplayed)) {
+		if (!inputLog.Open(INPUT_LOG_PATH, !isInputReplayed, MESH_WIDTH, MESH_HEIGHT)) {
+			glfwTerminate();
+			return -1;
+		}
+	}
+
+	renderCDTextureID = tempCDTextureID;
+	renderWTextureID = tempWTextureID;
+
+	// A tiled domain renders a preview of the domain and simulates one tile region at a time
+	if (isTiledDomain) {
+		tiledDomain.Allocate();
+		if (!GenerateTiledDomainTerrain(tiledDomain)) {
+			glfwTerminate();
+			return -1;
+		}
+		GenerateTiledDomainTextures(tiledDomain.TextureWidth, tiledDomain.TextureHeight);
+		tiledDomain.UploadPreview(renderCDTextureID, renderWTextureID);
+	}
+	
+	// Create the level of detail patch mesh shared by the terrain and water
+	ChunkedTerrain chunkedTerrain(MESH_WIDTH, MESH_HEIGHT, LOD_PATCH_RESOLUTION, MESH_SCALE, LOD_HEIGHT_BOUND);
+	chunkedTerrain.Generate();
+
+	// Or the max height pyramid of the heightfield ray marcher
+	HeightfieldRayMarcher heightfieldRayMarcher(MESH_WIDTH, MESH_HEIGHT);
+	if (isRayMarchedRender) {
+		heightfieldRayMarcher.Generate();
+	}
+
+	// Set static shader settings
+	// water increment shader static properties
+	waterIncrementComputeShader.use();
+	waterIncrementComputeShader.setFloat("Km", Km);
+	waterIncrementComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	waterIncrementComputeShader.setFloat("timeStep", timeStep);
+	// set source values
+	SetWaterSources(waterIncrementComputeShader, SIMULATION_WIDTH, SIMULATION_HEIGHT);
+	// set rain value
+	waterIncrementComputeShader.setInt("currentNumberRaindrops", numberOfRaindrops);
+	// Set source flow boolean
+	waterIncrementComputeShader.setBool("isSourceFlow", isSourceFlow);
+	// Set rain fall boolean
+	waterIncrementComputeShader.setBool("isRain", isRain);
+
+	// flux shader static properties
+	fluxUpdateComputeShader.use();
+	fluxUpdateComputeShader.setBool("isRegolith", isRegolith);
+	fluxUpdateComputeShader.setFloat("wKf", wKf);
+	fluxUpdateComputeShader.setFloat("rKf", rKf);
+	fluxUpdateComputeShader.setFloat("g", g);
+	fluxUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
+	fluxUpdateComputeShader.setFloat("pipeArea", PIPE_CROSS_SECTION_AREA);
+	fluxUpdateComputeShader.setFloat("width", MESH_WIDTH);
+	fluxUpdateComputeShader.setFloat("height", MESH_HEIGHT);
+	fluxUpdateComputeShader.setFloat("timeStep", timeStep);
+	fluxUpdateComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+
+	// height shader static properties
+	heightUpdateComputeShader.use();
+	heightUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
+	heightUpdateComputeShader.setFloat("width", MESH_WIDTH);
+	heightUpdateComputeShader.setFloat("height", MESH_HEIGHT);
+	heightUpdateComputeShader.setFloat("timeStep", timeStep);
+	heightUpdateComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+
+	// velocity update static properties
+	velocityFieldUpdateComputeShader.use();
+	velocityFieldUpdateComputeShader.setFloat("pipeLength", PIPE_LENGTH);
+	velocityFieldUpdateComputeShader.setFloat("width", MESH_WIDTH);
+	velocityFieldUpdateComputeShader.setFloat("height", MESH_HEIGHT);
+	velocityFieldUpdateComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+
+	// soil flow shader static properties
+	soilFlowComputeShader.use();
+	soilFlowComputeShader.setBool("isSoilFlow", isSoilFlow);
+	soilFlowComputeShader.setFloat("terrainTalusAngle", terrainTalusAngle);
+	soilFlowComputeShader.setFloat("vegetationTalusAngle", vegetationTalusAngle);
+	soilFlowComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	soilFlowComputeShader.setFloat("Kt", Kt);
+	soilFlowComputeShader.setFloat("pipeLength", PIPE_LENGTH);
+	soilFlowComputeShader.setFloat("cellSeparation", 1.0f / MESH_WIDTH);
+	soilFlowComputeShader.setFloat("diagCellSeparation", 1.414213562373095f / MESH_WIDTH);
+	soilFlowComputeShader.setFloat("width", MESH_WIDTH);
+	soilFlowComputeShader.setFloat("height", MESH_HEIGHT);
+	soilFlowComputeShader.setFloat("timeStep", timeStep);
+
+	// sediment erosion and deposition shader static properties
+	sedimentErosionAndDepositionComputeShader.use();
+	sedimentErosionAndDepositionComputeShader.setBool("isErosion", isErosion);
+	sedimentErosionAndDepositionComputeShader.setFloat("Kdmax", Kdmax);
+	sedimentErosionAndDepositionComputeShader.setFloat("Kc", Kc);
+	sedimentErosionAndDepositionComputeShader.setFloat("dissolvingConstant", Ks);
+	sedimentErosionAndDepositionComputeShader.setFloat("Kd", Kd);
+	sedimentErosionAndDepositionComputeShader.setFloat("timeStepScale", timeStep / TIME_STEP);
+	sedimentErosionAndDepositionComputeShader.setFloat("width", MESH_WIDTH);
+	sedimentErosionAndDepositionComputeShader.setFloat("height", MESH_HEIGHT);
+	sedimentErosionAndDepositionComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	sedimentErosionAndDepositionComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+
+	// sediment transportation shader static properties
+	sedimentTransportationComputeShader.use();
+	sedimentTransportationComputeShader.setFloat("width", MESH_WIDTH);
+	sedimentTransportationComputeShader.setFloat("height", MESH_HEIGHT);
+	sedimentTransportationComputeShader.setFloat("timeStep", timeStep);
+	sedimentTransportationComputeShader.setFloat("maxBacktrace", MAX_SEDIMENT_BACKTRACE);
+	sedimentTransportationComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+
+	// tile activity shader static properties
+	tileActivityComputeShader.use();
+	tileActivityComputeShader.setInt("numberTilesX", NUM_TILES_X);
+
+	// tile compaction shader static properties
+	tileCompactionComputeShader.use();
+	tileCompactionComputeShader.setInt("numberTilesX", NUM_TILES_X);
+	tileCompactionComputeShader.setInt("numberTilesY", NUM_TILES_Y);
+
+	// max reduction shader static properties
+	maxReductionComputeShader.use();
+	maxReductionComputeShader.setBool("isActiveTileDispatch", isActiveTileScheduling);
+	maxReductionComputeShader.setFloat("minimumWaterDepth", CFL_MIN_WATER_DEPTH);
+
+	// soil deposition shader static properties
+	soilFlowDepositionComputeShader.use();
+	soilFlowDepositionComputeShader.setFloat("width", MESH_WIDTH);
+	soilFlowDepositionComputeShader.setFloat("height", MESH_HEIGHT);
+	soilFlowDepositionComputeShader.setFloat("pipeLength", PIPE_LENGTH);
+
+	// evaporation shader static properties
+	evaporationComputeShader.use();
+	evaporationComputeShader.setFloat("evaporationConstant", Ke);
+	evaporationComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	evaporationComputeShader.setFloat("timeStep", timeStep);
+
+	// render prep shader static properties
+	renderPrepComputeShader.use();
+	renderPrepComputeShader.setFloat("size", MESH_TOTAL_SIZE);
+	renderPrepComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+
+	// height bounds shader static properties
+	heightBoundsComputeShader.use();
+	heightBoundsComputeShader.setIVec2("gridSize", MESH_WIDTH - 1, MESH_HEIGHT - 1);
+	heightBoundsComputeShader.setInt("patchResolution", LOD_PATCH_RESOLUTION);
+	heightBoundsComputeShader.setFloat("size", MESH_TOTAL_SIZE);
+
+	// patch culling shader static properties
+	patchCullingComputeShader.use();
+	patchCullingComputeShader.setVec2("gridSize", MESH_WIDTH - 1, MESH_HEIGHT - 1);
+	patchCullingComputeShader.setFloat("cellSize", MESH_SCALE);
+	patchCullingComputeShader.setInt("patchResolution", LOD_PATCH_RESOLUTION);
+
+	// heightfield ray march shader static properties
+	heightfieldRayMarchShader.use();
+	heightfieldRayMarchShader.setVec2("gridSize", MESH_WIDTH - 1, MESH_HEIGHT - 1);
+	heightfieldRayMarchShader.setFloat("cellSize", MESH_SCALE);
+	heightfieldRayMarchShader.setInt("maxHeightLevels", heightfieldRayMarcher.MaxHeightLevels);
+	heightfieldRayMarchShader.setFloat("terrainShininess", 1.0f);
+	heightfieldRayMarchShader.setFloat("waterShininess", 64.0f);
+	heightfieldRayMarchShader.setVec3("terrainColor", 0.87f, 0.85f, 0.6f);
+	heightfieldRayMarchShader.setVec3("vegetationColor", 0.31f, 0.5f, 0.1f);
+	heightfieldRayMarchShader.setVec3("deadVegetationColor", 0.6f, 0.4f, 0.2f);
+	heightfieldRayMarchShader.setVec3("terrainSpecularColor", 0.0f, 0.0f, 0.0f);
+	heightfieldRayMarchShader.setVec3("waterColor", 0.1f, 0.6f, 1.0f);
+	heightfieldRayMarchShader.setVec3("waterSpecularColor", 1.0f, 1.0f, 1.0f);
+	heightfieldRayMarchShader.setInt("detailNoiseTexture", 1);
+	heightfieldRayMarchShader.setInt("maxHeightTexture", 2);
+	// set heightfield ray march light properties
+	heightfieldRayMarchShader.setVec3("dirLight.direction", lightDirection);
+	heightfieldRayMarchShader.setVec3("dirLight.ambient", 0.4f, 0.4f, 0.4f);
+	heightfieldRayMarchShader.setVec3("dirLight.diffuse", 0.5f, 0.5f, 0.5f);
+	heightfieldRayMarchShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
+
+	// terrain render shader static properties
+	terrainRenderShader.use();
+	terrainRenderShader.setFloat("size", MESH_TOTAL_SIZE);
+	terrainRenderShader.setVec2("gridSize", MESH_WIDTH - 1, MESH_HEIGHT - 1);
+	terrainRenderShader.setFloat("cellSize", MESH_SCALE);
+	terrainRenderShader.setInt("patchResolution", LOD_PATCH_RESOLUTION);
+	terrainRenderShader.setFloat("terrainShininess", 1.0f);
+	terrainRenderShader.setFloat("waterShininess", 64.0f);
+	terrainRenderShader.setVec3("terrainColor", 0.87f, 0.85f, 0.6f);
+	terrainRenderShader.setVec3("vegetationColor", 0.31f, 0.5f, 0.1f);
+	terrainRenderShader.setVec3("deadVegetationColor", 0.6f, 0.4f, 0.2f);
+	terrainRenderShader.setVec3("terrainSpecularColor", 0.0f, 0.0f, 0.0f);
+	terrainRenderShader.setVec3("waterColor", 0.1f, 0.6f, 1.0f);
+	terrainRenderShader.setVec3("waterSpecularColor", 1.0f, 1.0f, 1.0f);
+	terrainRenderShader.setInt("detailNoiseTexture", 1);
+	// set terrain render light properties
+	terrainRenderShader.setVec3("dirLight.direction", lightDirection);
+	terrainRenderShader.setVec3("dirLight.ambient", 0.4f, 0.4f, 0.4f);
+	terrainRenderShader.setVec3("dirLight.diffuse", 0.5f, 0.5f, 0.5f);
+	terrainRenderShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
+
+	// water render shader static properties
+	waterRenderShader.use();
+	waterRenderShader.setFloat("size", MESH_TOTAL_SIZE);
+	waterRenderShader.setVec2("gridSize", MESH_WIDTH - 1, MESH_HEIGHT - 1);
+	waterRenderShader.setFloat("cellSize", MESH_SCALE);
+	waterRenderShader.setInt("patchResolution", LOD_PATCH_RESOLUTION);
+	waterRenderShader.setFloat("terrainShininess", 1.0f);
+	waterRenderShader.setFloat("waterShininess", 64.0f);
+	waterRenderShader.setVec3("terrainColor", 0.87f, 0.85f, 0.6f);
+	waterRenderShader.setVec3("vegetationColor", 0.31f, 0.5f, 0.1f);
+	waterRenderShader.setVec3("terrainSpecularColor", 0.0f, 0.0f, 0.0f);
+	waterRenderShader.setVec3("waterColor", 0.1f, 0.6f, 1.0f);
+	waterRenderShader.setVec3("waterSpecularColor", 1.0f, 1.0f, 1.0f);
+	// set water render light properties
+	waterRenderShader.setVec3("dirLight.direction", lightDirection);
+	waterRenderShader.setVec3("dirLight.ambient", 0.4f, 0.4f, 0.4f);
+	waterRenderShader.setVec3("dirLight.diffuse", 0.5f, 0.5f, 0.5f);
+	waterRenderShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
+
+	// Coarse Water Spin Up: spread the source water on a coarse grid and prolong it to the full grid before erosion starts
+	// A tiled domain has no full grid on the GPU and starts dry
+	if (isCoarseWaterSpinUp && !isTiledDomain) {
+		GenerateCoarseTextures(COARSE_MESH_WIDTH, COARSE_MESH_HEIGHT);
+
+		Shader restrictColumnDataComputeShader("restrictColumnData.ComputeShader");
+		Shader prolongWaterComputeShader("prolongWater.ComputeShader");
+		Shader coarseWaterIncrementComputeShader("waterIncrement.ComputeShader");
+		Shader coarseFluxUpdateComputeShader("fluxUpdate.ComputeShader");
+		Shader coarseHeightUpdateComputeShader("heightUpdate.ComputeShader");
+		Shader coarseEvaporationComputeShader("evaporation.ComputeShader");
+
+		const GLuint coarseGroupsX = COARSE_MESH_WIDTH / WORK_GROUP_SIZE_X;
+		const GLuint coarseGroupsY = COARSE_MESH_HEIGHT / WORK_GROUP_SIZE_Y;
+
+		// coarse water increment shader properties, only the sources add water during the spin up
+		coarseWaterIncrementComputeShader.use();
+		coarseWaterIncrementComputeShader.setFloat("Km", Km);
+		coarseWaterIncrementComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+		coarseWaterIncrementComputeShader.setFloat("timeStep", COARSE_TIME_STEP);
+		SetWaterSources(coarseWaterIncrementComputeShader, COARSE_MESH_WIDTH, COARSE_MESH_HEIGHT);
+		coarseWaterIncrementComputeShader.setBool("isSourceFlow", isSourceFlow);
+		coarseWaterIncrementComputeShader.setBool("isRain", false);
+
+		// coarse flux shader properties, regolith is left to the full grid
+		coarseFluxUpdateComputeShader.use();
+		coarseFluxUpdateComputeShader.setBool("isRegolith", false);
+		coarseFluxUpdateComputeShader.setFloat("wKf", wKf);
+		coarseFluxUpdateComputeShader.setFloat("rKf", rKf);
+		coarseFluxUpdateComputeShader.setFloat("g", g);
+		coarseFluxUpdateComputeShader.setFloat("pipeLength", COARSE_PIPE_LENGTH);
+		coarseFluxUpdateComputeShader.setFloat("pipeArea", 20 * COARSE_PIPE_LENGTH);
+		coarseFluxUpdateComputeShader.setFloat("width", COARSE_MESH_WIDTH);
+		coarseFluxUpdateComputeShader.setFloat("height", COARSE_MESH_HEIGHT);
+		coarseFluxUpdateComputeShader.setFloat("timeStep", COARSE_TIME_STEP);
+		coarseFluxUpdateComputeShader.setBool("isActiveTileDispatch", false);
+
+		// coarse height shader properties
+		coarseHeightUpdateComputeShader.use();
+		coarseHeightUpdateComputeShader.setFloat("pipeLength", COARSE_PIPE_LENGTH);
+		coarseHeightUpdateComputeShader.setFloat("width", COARSE_MESH_WIDTH);
+		coarseHeightUpdateComputeShader.setFloat("height", COARSE_MESH_HEIGHT);
+		coarseHeightUpdateComputeShader.setFloat("timeStep", COARSE_TIME_STEP);
+		coarseHeightUpdateComputeShader.setBool("isActiveTileDispatch", false);
+
+		// coarse evaporation shader properties
+		coarseEvaporationComputeShader.use();
+		coarseEvaporationComputeShader.setFloat("evaporationConstant", Ke);
+		coarseEvaporationComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+		coarseEvaporationComputeShader.setFloat("timeStep", COARSE_TIME_STEP);
+
+		// Restrict the initial column data to the coarse grid
+		restrictColumnDataComputeShader.use();
+		restrictColumnDataComputeShader.setInt("gridFactor", COARSE_GRID_FACTOR);
+		// Link coarseCDTextureID to the output (binding = 0) of the restrict column data shader
+		glBindImageTexture(0, coarseCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+		// Link CDTextureID to binding = 1 in the restrict column data shader
+		glBindImageTexture(1, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+		glDispatchCompute(coarseGroupsX, coarseGroupsY, 1);
+		// Prevent from moving on until all compute shader calculations are done
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		for (unsigned int step = 0; step < COARSE_SPIN_UP_STEPS; step++) {
+			// Coarse water increment
+			coarseWaterIncrementComputeShader.use();
+			glBindImageTexture(0, tempCoarseCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(1, tempCoarseWTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(2, coarseCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(3, coarseWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+			glDispatchCompute(coarseGroupsX, coarseGroupsY, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+			// Coarse flux update
+			coarseFluxUpdateComputeShader.use();
+			glBindImageTexture(0, tempCoarseFTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(1, tempCoarseRTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(2, tempCoarseCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(3, tempCoarseWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(4, coarseFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(5, coarseRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+			glDispatchCompute(coarseGroupsX, coarseGroupsY, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+			// Coarse height update
+			coarseHeightUpdateComputeShader.use();
+			glBindImageTexture(0, coarseCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(1, tempCoarseCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(2, tempCoarseFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(3, tempCoarseRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+			glDispatchCompute(coarseGroupsX, coarseGroupsY, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+			// Coarse evaporation
+			coarseEvaporationComputeShader.use();
+			glBindImageTexture(0, tempCoarseCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+			glBindImageTexture(1, coarseCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+			glDispatchCompute(coarseGroupsX, coarseGroupsY, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+			// The outputs of this step become the inputs of the next one
+			swap(coarseCDTextureID, tempCoarseCDTextureID);
+			swap(coarseWTextureID, tempCoarseWTextureID);
+			swap(coarseFTextureID, tempCoarseFTextureID);
+			swap(coarseRTextureID, tempCoarseRTextureID);
+		}
+
+		// Prolong the coarse water surface to the full grid, every fine column holds the water above its own ground
+		prolongWaterComputeShader.use();
+		prolongWaterComputeShader.setInt("gridFactor", COARSE_GRID_FACTOR);
+		// Link CDTextureID to binding = 0 in the prolong water shader
+		glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_READ_WRITE, INTERNAL_TEXTURE_FORMAT);
+		// Link coarseCDTextureID to binding = 1 in the prolong water shader
+		glBindImageTexture(1, coarseCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+		glDispatchCompute((GLuint)NUM_GROUPS_X, (GLuint)NUM_GROUPS_Y, NUM_GROUPS_Z);
+		// Prevent from moving on until all compute shader calculations are done
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+		// The coarse grid is no longer needed
+		unsigned int coarseTextureIDs[8] = { coarseCDTextureID, coarseWTextureID, coarseFTextureID, coarseRTextureID, tempCoarseCDTextureID, tempCoarseWTextureID, tempCoarseFTextureID, tempCoarseRTextureID };
+		glDeleteTextures(8, coarseTextureIDs);
+		glDeleteProgram(restrictColumnDataComputeShader.ID);
+		glDeleteProgram(prolongWaterComputeShader.ID);
+		glDeleteProgram(coarseWaterIncrementComputeShader.ID);
+		glDeleteProgram(coarseFluxUpdateComputeShader.ID);
+		glDeleteProgram(coarseHeightUpdateComputeShader.ID);
+		glDeleteProgram(coarseEvaporationComputeShader.ID);
+	}
+
+	// A multi-process grid only keeps the rows of this process's strip and its halos, every process has set up the whole grid the same way
+	if (isMultiProcess) {
+		GenerateStripTextures(stripDomain.TextureFirstRow, stripDomain.TextureHeight);
+		simulationGroupsY = (stripDomain.TextureHeight + WORK_GROUP_SIZE_Y - 1) / WORK_GROUP_SIZE_Y;
+
+		waterIncrementComputeShader.use();
+		waterIncrementComputeShader.setIVec2("gridOffset", 0, stripDomain.TextureFirstRow);
+		sedimentTransportationComputeShader.use();
+		sedimentTransportationComputeShader.setIVec2("gridOffset", 0, stripDomain.TextureFirstRow);
+		// The closed boundary checks run against the strip, whose halo rows are overwritten before they are read
+		fluxUpdateComputeShader.use();
+		fluxUpdateComputeShader.setFloat("height", stripDomain.TextureHeight);
+		heightUpdateComputeShader.use();
+		heightUpdateComputeShader.setFloat("height", stripDomain.TextureHeight);
+		velocityFieldUpdateComputeShader.use();
+		velocityFieldUpdateComputeShader.setFloat("height", stripDomain.TextureHeight);
+		soilFlowComputeShader.use();
+		soilFlowComputeShader.setFloat("height", stripDomain.TextureHeight);
+		soilFlowDepositionComputeShader.use();
+		soilFlowDepositionComputeShader.setFloat("height", stripDomain.TextureHeight);
+	}
+
+	float sourceFlowTime = 0;
+	float rainFallTime = 0;
+	float soilFlowTime = 0;
+
+	glm::mat4 projection;
+	glm::mat4 view;
+	glm::mat4 model;
+
+	glfwSetTime(0);
+	float currentFrame;
+	float cycleCount = 1;
+	float startTime;
+	float endTime;
+
+	MetricsReporter metricsReporter(METRICS_FORMAT, METRICS_REPORT_INTERVAL);
+	string metricsPath = METRICS_PATH;
+	if (!metricsPath.empty() && processRank > 0) {
+		metricsPath += "." + to_string(processRank);
+	}
+	if (!metricsReporter.Start(metricsPath)) {
+		glfwTerminate();
+		return -1;
+	}
+
+	// render loop
+	// -----------
+	while (!glfwWindowShouldClose(window))
+	{
+		// per-frame time logic
+		// --------------------
+		// A replayed frame runs on the time and input of the recorded one, which started at the same simulation step and time step
+		if (inputLog.IsReplaying) {
+			if (!inputLog.Read(inputFrame)) {
+				break;
+			}
+			if (!isReplayDiverged && (inputFrame.SimulationStep != simulationStep || inputFrame.TimeStep != timeStep)) {
+				cout << "ERROR::INPUT_LOG::REPLAY_DIVERGED at step " << simulationStep << endl;
+				isReplayDiverged = true;
+			}
+		}
+		else {
+			inputFrame.Time = (float)glfwGetTime();
+			inputFrame.SimulationStep = simulationStep;
+			inputFrame.TimeStep = timeStep;
+		}
+		currentFrame = inputFrame.Time;
+		deltaTime = currentFrame - lastFrame;
+		lastFrame = currentFrame;
+
+		// An offline flythrough runs on video time
+		if (isOfflineFlythrough) {
+			deltaTime = 1.0f / FLYTHROUGH_FRAME_RATE;
+		}
+
+		//cout << 1 / deltaTime << endl;
+
+		// Grow or shrink the render resolution towards the frame time budget, the number of steps only changes at the scale limits
+		bool isRenderScaleChanged = false;
+		if (isDynamicRenderResolution && !isOfflineFlythrough) {
+			if (deltaTime > 1.1f * TARGET_FRAME_TIME && renderScale > MIN_RENDER_SCALE) {
+				renderScale = max(MIN_RENDER_SCALE, renderScale - RENDER_SCALE_STEP);
+				isRenderScaleChanged = true;
+			}
+			else if (deltaTime < 0.9f * TARGET_FRAME_TIME && renderScale < MAX_RENDER_SCALE) {
+				renderScale = min(MAX_RENDER_SCALE, renderScale + RENDER_SCALE_STEP);
+				isRenderScaleChanged = true;
+			}
+		}
+
+		// Grow or shrink the number of simulation steps per frame towards the frame time budget
+		if (isFrameTimeBudget && !isRenderScaleChanged && !isOfflineFlythrough) {
+			if (deltaTime < 0.9f * TARGET_FRAME_TIME) {
+				simulationStepsPerFrame = min(MAX_SIMULATION_STEPS_PER_FRAME, max(simulationStepsPerFrame + 1, (int)(simulationStepsPerFrame * min(2.0f, TARGET_FRAME_TIME / deltaTime))));
+			}
+			else if (deltaTime > 1.1f * TARGET_FRAME_TIME) {
+				simulationStepsPerFrame = max(1, (int)(simulationStepsPerFrame * max(0.5f, TARGET_FRAME_TIME / deltaTime)));
+			}
+		}
+
+		// A paused simulation runs no steps
+		int frameSimulationSteps = isSimulationPaused ? 0 : simulationStepsPerFrame;
+
+		// Every process of a multi-process run steps with the first one's frame time and number of steps
+		if (isMultiProcess && !stripDomain.SynchronizeFrame(deltaTime, frameSimulationSteps, false)) {
+			break;
+		}
+
+		// input
+		// -----
+		processInput(window);
+
+		startTime = (float)glfwGetTime();
+
+		FrameMetrics frameMetrics;
+		frameMetrics.Steps = frameSimulationSteps;
+		frameMetrics.MaxReductions = 0;
+		frameMetrics.DeltaTime = deltaTime;
+		frameMetrics.RenderTime = 0.0f;
+		frameMetrics.RenderScale = isDynamicRenderResolution ? renderScale : 1.0f;
+
+		// Run simulationStepsPerFrame simulation steps for every rendered frame, none while paused
+		for (int substep = 0; substep < frameSimulationSteps; substep++) {
+			// Adaptive Time Step: once the last max velocity/depth reduction has finished on the GPU, pick the largest stable time step
+			// The time step only changes in the steps starting the next reduction, whatever the frame timing, so every run, and every process
+			// of a multi-process run, takes the same time steps. By then the reduction has had TIME_STEP_REDUCTION_INTERVAL steps to finish
+			bool isMaxReductionDone = false;
+			if (isAdaptiveTimeStep && maxReductionFence != 0 && (simulationStep + 1) % TIME_STEP_REDUCTION_INTERVAL == 0) {
+				while (glClientWaitSync(maxReductionFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+				isMaxReductionDone = true;
+			}
+
+			if (isMaxReductionDone) {
+				glDeleteSync(maxReductionFence);
+				maxReductionFence = 0;
+				frameMetrics.MaxReductions++;
+
+				GLuint maxValues[2];
+				float maxVelocity;
+				float maxWaterDepth;
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, maxReductionBufferID);
+				glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(maxValues), maxValues);
+				memcpy(&maxVelocity, &maxValues[0], sizeof(float));
+				memcpy(&maxWaterDepth, &maxValues[1], sizeof(float));
+
+				if (isMultiProcess) {
+					float maxima[2] = { maxVelocity, maxWaterDepth };
+					stripDomain.Communicator.AllReduceMax(maxima, 2);
+					maxVelocity = maxima[0];
+					maxWaterDepth = maxima[1];
+				}
+
+				timeStep = ComputeStableTimeStep(maxVelocity, maxWaterDepth, timeStep);
+
+				waterIncrementComputeShader.use();
+				waterIncrementComputeShader.setFloat("timeStep", timeStep);
+				fluxUpdateComputeShader.use();
+				fluxUpdateComputeShader.setFloat("timeStep", timeStep);
+				heightUpdateComputeShader.use();
+				heightUpdateComputeShader.setFloat("timeStep", timeStep);
+				soilFlowComputeShader.use();
+				soilFlowComputeShader.setFloat("timeStep", timeStep);
+				sedimentErosionAndDepositionComputeShader.use();
+				sedimentErosionAndDepositionComputeShader.setFloat("timeStepScale", timeStep / TIME_STEP);
+				sedimentTransportationComputeShader.use();
+				sedimentTransportationComputeShader.setFloat("timeStep", timeStep);
+				evaporationComputeShader.use();
+				evaporationComputeShader.setFloat("timeStep", timeStep);
+			}
+
+			// Set Water Increment Shader Properties
+			waterIncrementComputeShader.use();
+			if (isSourceFlow && sourceFlowTime < SOURCE_FLOW_CUTOFF_TIME) {
+				sourceFlowTime += timeStep;
+			}
+			else if (isSourceFlow) {
+				isSourceFlow = false;
+				waterIncrementComputeShader.setBool("isSourceFlow", isSourceFlow);
+			}
+
+			if (isRain && rainFallTime < RAIN_CUTOFF_TIME) {
+				rainFallTime += timeStep;
+
+				// The raindrops of a step are drawn from a sequence seeded by the step, so every process of a multi-process run, and
+				// a replayed run, rains on the same cells
+				srand(simulationStep);
+				for (int i = 0; i < numberOfRaindrops; i++) {
+					string raindrop = "raindrops[";
+					raindrop += std::to_string(i);
+					string position = "].position";
+					string radius = "].radius";
+					string increment = "].Kir";
+
+					float Kir = (float)glm::linearRand(3, 5);
+
+					rainRadius = MESH_WIDTH / 100;
+
+					int x = glm::linearRand(rainRadius, (int)SIMULATION_WIDTH - rainRadius);
+					int y = glm::linearRand(rainRadius, (int)SIMULATION_HEIGHT - rainRadius);
+
+					waterIncrementComputeShader.setIVec2(raindrop + position, x, y);
+					waterIncrementComputeShader.setInt(raindrop + radius, rainRadius);
+					waterIncrementComputeShader.setFloat(raindrop + increment, Kir);
+				}
+			}
+			else if (isRain) {
+				isRain = false;
+				waterIncrementComputeShader.setBool("isRain", isRain);
+			}
+
+			// Set Soil Flow Shader Properties
+			soilFlowComputeShader.use();
+			if (soilFlowTime < SOIL_FLOW_CUTOFF_TIME) {
+				soilFlowTime += timeStep;
+			}
+			else if (isSoilFlow) {
+				isSoilFlow = false;
+				soilFlowComputeShader.setBool("isSoilFlow", isSoilFlow);
+			}
+
+			// Max reductions are started every TIME_STEP_REDUCTION_INTERVAL steps and read back at the start of the next one
+			bool isMaxReductionStep = isAdaptiveTimeStep && maxReductionFence == 0 && (simulationStep + 1) % TIME_STEP_REDUCTION_INTERVAL == 0;
+			if (isMaxReductionStep) {
+				const GLuint emptyMaxValues[2] = { 0, 0 };
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, maxReductionBufferID);
+				glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyMaxValues), emptyMaxValues);
+			}
+
+			// A tiled domain steps its tiles in turn, any other grid is a single tile
+			const unsigned int numberSimulationTiles = isTiledDomain ? tiledDomain.NumberTiles() : 1;
+			const unsigned int tileTextureIDs[TILED_DOMAIN_FIELDS] = { CDTextureID, WTextureID, FTextureID, RTextureID, VTextureID };
+			bool isTileFileFailed = false;
+			for (unsigned int tile = 0; tile < numberSimulationTiles; tile++) {
+				if (isTiledDomain) {
+					// Stream the tile region in and fit the passes to it
+					TiledDomain::Region region = tiledDomain.BeginTile(tile, tileTextureIDs);
+					simulationGroupsX = region.width / WORK_GROUP_SIZE_X;
+					simulationGroupsY = region.height / WORK_GROUP_SIZE_Y;
+
+					waterIncrementComputeShader.use();
+					waterIncrementComputeShader.setIVec2("gridOffset", region.x, region.y);
+					sedimentTransportationComputeShader.use();
+					sedimentTransportationComputeShader.setIVec2("gridOffset", region.x, region.y);
+					// The closed boundary checks run against the region, sediment erosion and transportation keep the grid scale
+					fluxUpdateComputeShader.use();
+					fluxUpdateComputeShader.setFloat("width", region.width);
+					fluxUpdateComputeShader.setFloat("height", region.height);
+					heightUpdateComputeShader.use();
+					heightUpdateComputeShader.setFloat("width", region.width);
+					heightUpdateComputeShader.setFloat("height", region.height);
+					velocityFieldUpdateComputeShader.use();
+					velocityFieldUpdateComputeShader.setFloat("width", region.width);
+					velocityFieldUpdateComputeShader.setFloat("height", region.height);
+					soilFlowComputeShader.use();
+					soilFlowComputeShader.setFloat("width", region.width);
+					soilFlowComputeShader.setFloat("height", region.height);
+					soilFlowDepositionComputeShader.use();
+					soilFlowDepositionComputeShader.setFloat("width", region.width);
+					soilFlowDepositionComputeShader.setFloat("height", region.height);
+				}
+
+				if (isMultiProcess) {
+					// Halo rows of the column data and water data from the neighbors' last step
+					const unsigned int haloTextureIDs[2] = { CDTextureID, WTextureID };
+					stripDomain.ExchangeHalos(haloTextureIDs, 2);
+				}
+
+				// First Pass: Water Increment Step
+				waterIncrementComputeShader.use();
+				// Link tempCDTextureID to the output (binding = 0) of the water increment shader
+				glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempWTextureID to the output (binding = 1) of the water increment shader
+				glBindImageTexture(1, tempWTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 2 in water increment shader
+				glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link WTextureID to binding = 3 in water increment shader
+				glBindImageTexture(3, WTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// The first step keeps the full tile list it starts with, so every temp flux and velocity texel is written once
+				if (isActiveTileScheduling && simulationStep > 0) {
+					// Active Tile Pass: Mark every tile holding water, regolith, sediment or flux
+					tileActivityComputeShader.use();
+					// Link CDTextureID to binding = 0 in tile activity shader
+					glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link tempCDTextureID to binding = 1 in tile activity shader
+					glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link WTextureID to binding = 2 in tile activity shader
+					glBindImageTexture(2, WTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link FTextureID to binding = 3 in tile activity shader
+					glBindImageTexture(3, FTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link RTextureID to binding = 4 in tile activity shader
+					glBindImageTexture(4, RTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link VTextureID to binding = 5 in tile activity shader
+					glBindImageTexture(5, VTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+					glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+					// Prevent from moving on until the tile activity mask is written
+					glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+					// Reset the indirect dispatch arguments to zero active tiles
+					const GLuint emptyDispatch[3] = { 0, 1, 1 };
+					glBindBuffer(GL_SHADER_STORAGE_BUFFER, activeTilesBufferID);
+					glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyDispatch), emptyDispatch);
+
+					// Compact the dilated activity mask into the active tile list
+					tileCompactionComputeShader.use();
+					glDispatchCompute((NUM_TILES_X + TILE_COMPACTION_GROUP_SIZE - 1) / TILE_COMPACTION_GROUP_SIZE, (NUM_TILES_Y + TILE_COMPACTION_GROUP_SIZE - 1) / TILE_COMPACTION_GROUP_SIZE, 1);
+					// Prevent from moving on until the active tile list and dispatch arguments are written
+					glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+				}
+
+				// Second Pass: Flux(Water and Regolith) Update Step
+				fluxUpdateComputeShader.use();
+				// Link tempFTextureID to the output (binding = 0) in flux update shader
+				glBindImageTexture(0, tempFTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempRTextureID to the output (binding = 1) in flux update shader
+				glBindImageTexture(1, tempRTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 2 in flux update shader
+				glBindImageTexture(2, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempWTextureID to binding = 3 in flux update shader
+				glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link FTextureID to binding = 4 in flux update shader
+				glBindImageTexture(4, FTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link RTextureID to binding = 5 in flux update shader
+				glBindImageTexture(5, RTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				DispatchHydraulicPass();
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				if (isMultiProcess) {
+					// Halo rows of the new flux for the height and velocity field updates
+					const unsigned int haloTextureIDs[2] = { tempFTextureID, tempRTextureID };
+					stripDomain.ExchangeHalos(haloTextureIDs, 2);
+				}
+
+				// Third Pass: Height (Water and Regolith) Update Step
+				heightUpdateComputeShader.use();
+				// Link CDTextureID to binding = 0 in water height update shader
+				glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 1 in water height update shader
+				glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempFTextureID to binding = 2 in water height update shader
+				glBindImageTexture(2, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempRTextureID to binding = 2 in water height update shader
+				glBindImageTexture(3, tempRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				DispatchHydraulicPass();
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	
+				// Sixth Pass: Velocity Field Update Step
+				velocityFieldUpdateComputeShader.use();
+				// Link tempVTextureID to binding = 0 in velocity field update shader
+				glBindImageTexture(0, tempVTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 1 in velocity field update shader
+				glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 2 in velocity field update shader
+				glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempFTextureID to binding = 3 in velocity field update shader
+				glBindImageTexture(3, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link VTextureID to binding = 4 in velocity field update shader
+				glBindImageTexture(4, VTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				DispatchHydraulicPass();
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Sixth Pass: Soil Flow Step
+				soilFlowComputeShader.use();
+				// Link STextureID to binding = 0 in soil flow shader
+				glBindImageTexture(0, STextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link SCTextureID to binding = 1 in soil flow shader
+				glBindImageTexture(1, SCTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 2 in soil flow shader
+				glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempWTextureID to binding = 3 in soil flow shader
+				glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				if (isMultiProcess) {
+					// Halo rows of the soil flow for the soil flow deposition
+					const unsigned int haloTextureIDs[2] = { STextureID, SCTextureID };
+					stripDomain.ExchangeHalos(haloTextureIDs, 2);
+				}
+
+				// Seventh Pass: Sediment Erosion/Deposition Step
+				sedimentErosionAndDepositionComputeShader.use();
+				// Link tempCDTextureID to output (binding = 0) in sediment erosion/deposition shader
+				glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link WTextureID to output (binding = 1) in sediment erosion/deposition shader
+				glBindImageTexture(1, WTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 2 in sediment erosion/deposition shader
+				glBindImageTexture(2, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempWTextureID to binding = 3 in sediment erosion/deposition shader
+				glBindImageTexture(3, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempVTextureID to binding = 4 in sediment erosion/deposition shader
+				glBindImageTexture(4, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				DispatchHydraulicPass();
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				if (isMultiProcess) {
+					// Halo rows of the suspended sediment for the backtracking of the sediment transportation
+					const unsigned int haloTextureIDs[1] = { WTextureID };
+					stripDomain.ExchangeHalos(haloTextureIDs, 1);
+				}
+
+				// Eighth Pass: Sediment Transportation Step
+				sedimentTransportationComputeShader.use();
+				// Link tempWTextureID to binding = 0 in sediment transportation shader
+				glBindImageTexture(0, tempWTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link WTextureID to binding = 1 in sediment transportation shader
+				glBindImageTexture(1, WTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempVTextureID to binding = 2 in sediment transportation shader
+				glBindImageTexture(2, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				DispatchHydraulicPass();
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Sixth Pass: Soil Flow Deposition Step
+				soilFlowDepositionComputeShader.use();
+				// Link CDTextureID to binding = 0 in soil flow deposition shader
+				glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 1 in soil flow deposition shader
+				glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link SCTextureID to binding = 2 in soil flow deposition shader
+				glBindImageTexture(2, STextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 3 in soil flow deposition shader
+				glBindImageTexture(3, SCTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Ninth Pass: Evaporation Step
+				evaporationComputeShader.use();
+				// Link tempCDTextureID to the output (binding = 0) of the evaporation shader
+				glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link CDTextureID to binding = 1 in the evaporation shader
+				glBindImageTexture(1, CDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Max Reduction Pass: find the max water velocity and depth for the adaptive time step
+				if (isMaxReductionStep) {
+					maxReductionComputeShader.use();
+					// Link tempCDTextureID to binding = 0 in max reduction shader
+					glBindImageTexture(0, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+					// Link tempVTextureID to binding = 1 in max reduction shader
+					glBindImageTexture(1, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+					DispatchHydraulicPass();
+					// Make the reduced values visible to the buffer read back
+					glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+				}
+
+				// Swap info in tempCDTexture to CDTexture
+				swapBuffersComputeShader.use();
+				// Link CDTextureID to the output (binding = 0) of the swap buffers shader
+				glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 1 in the swap buffers shader
+				glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		
+
+				// Swap info in tempWTexture to WTexture
+				swapBuffersComputeShader.use();
+				// Link CDTextureID to the output (binding = 0) of the swap buffers shader
+				glBindImageTexture(0, WTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempCDTextureID to binding = 1 in the swap buffers shader
+				glBindImageTexture(1, tempWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Swap info in tempFTexture to FTexture
+				swapBuffersComputeShader.use();
+				// Link FTextureID to the output (binding = 0) of the swap buffers shader
+				glBindImageTexture(0, FTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempFTextureID to binding = 1 in the swap buffers shader
+				glBindImageTexture(1, tempFTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Swap info in tempRTexture to RTexture
+				swapBuffersComputeShader.use();
+				// Link VTextureID to the output (binding = 0) of the swap buffers shader
+				glBindImageTexture(0, RTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempVTextureID to binding = 1 in the swap buffers shader
+				glBindImageTexture(1, tempRTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Swap info in tempVTexture to VTexture
+				swapBuffersComputeShader.use();
+				// Link VTextureID to the output (binding = 0) of the swap buffers shader
+				glBindImageTexture(0, VTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+				// Link tempVTextureID to binding = 1 in the swap buffers shader
+				glBindImageTexture(1, tempVTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+		
+				glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+				// Prevent from moving on until all compute shader calculations are done
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				// Read the tile interior back and stage the next tile while this one runs, a tile file that failed ends the run
+				if (isTiledDomain && !tiledDomain.EndTile(tile, tileTextureIDs)) {
+					isTileFileFailed = true;
+					break;
+				}
+			}
+
+			if (isTiledDomain && (isTileFileFailed || !tiledDomain.EndStep())) {
+				glfwSetWindowShouldClose(window, true);
+				break;
+			}
+
+			simulationTime += timeStep;
+			simulationStep++;
+
+			if (isMaxReductionStep) {
+				maxReductionFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			}
+		}
+
+		// The render textures only change in frames that ran simulation steps, and are set up by the first one, which may start paused
+		bool isRenderDataChanged = frameSimulationSteps > 0 || cycleCount == 1;
+
+		// Render the domain preview as it stands after this frame's steps
+		if (isTiledDomain && isRenderDataChanged) {
+			tiledDomain.UploadPreview(renderCDTextureID, renderWTextureID);
+		}
+
+		// Gather the strips of a multi-process grid in the first process, which renders them
+		if (isMultiProcess && isRenderDataChanged) {
+			stripDomain.GatherRenderTextures(CDTextureID, WTextureID, renderCDTextureID, renderWTextureID);
+		}
+
+		if (isStateExportRequested) {
+			isStateExportRequested = false;
+			ExportState(simulationStep);
+		}
+
+		endTime = (float)glfwGetTime();
+		frameMetrics.SimulationTime = endTime - startTime;
+		frameMetrics.SimulationStep = simulationStep;
+		frameMetrics.TimeStep = timeStep;
+
+		if (processRank > 0) {
+			metricsReporter.Record(frameMetrics);
+			cycleCount++;
+			glfwPollEvents();
+			continue;
+		}
+
+		// Final Pass: Terrain Render Step
+		// render
+		// ------
+		// A dynamic render resolution draws to the scene framebuffer at the scaled size, an offline flythrough to the recorder's
+		unsigned int renderWidth = SCR_WIDTH;
+		unsigned int renderHeight = SCR_HEIGHT;
+		if (isOfflineFlythrough) {
+			renderWidth = FLYTHROUGH_WIDTH;
+			renderHeight = FLYTHROUGH_HEIGHT;
+			frameRecorder.Bind();
+		}
+		else if (isDynamicRenderResolution) {
+			renderWidth = max(1u, (unsigned int)(renderScale * SCR_WIDTH));
+			renderHeight = max(1u, (unsigned int)(renderScale * SCR_HEIGHT));
+			glBindFramebuffer(GL_FRAMEBUFFER, sceneFramebufferID);
+			glViewport(0, 0, renderWidth, renderHeight);
+		}
+
+		glClearColor(0.8f, 0.8f, 0.8f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		if (isOfflineFlythrough) {
+			flythroughPath.Apply(camera, simulationTime);
+			view = camera.GetViewMatrix();
+		}
+		else if (isMovieMode && isCameraMoving) {
+			if (isSquarePillarTerrain) {
+				if (currentFrame > 120) {
+					float radius = 2.0f;
+					float speed = 0.1f;
+					float camX = sin((currentFrame - 18) * speed) * radius;
+					float camZ = cos((currentFrame - 18) * speed) * radius;
+
+					view = glm::lookAt(glm::vec3(camX, 1.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+				}
+				else {
+					view = camera.GetViewMatrix();
+				}
+			}
+			else {
+				float camX;
+				float camZ;
+				if (cameraChange == 0 && currentFrame > 10) {
+					float radius = 3.0f;
+					float speed = 0.1f;
+					if (currentFrame < 30) {
+						camX = sin((currentFrame - 10) * speed) * radius;
+						camZ = cos((currentFrame - 10) * speed) * radius;
+					}
+
+					view = glm::lookAt(glm::vec3(camX, 1.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+				}
+				else {
+					view = camera.GetViewMatrix();
+				}
+			}
+		}
+		else {
+			// camera/view transformation
+			view = camera.GetViewMatrix();
+		}
+
+		// projection matrix
+		projection = glm::perspective(glm::radians(camera.Zoom), (float)renderWidth / (float)renderHeight, 0.1f, 100.0f);
+
+		model = glm::mat4(1.0f);
+		model = glm::translate(model, glm::vec3(-(MESH_TOTAL_SIZE / 2.0f), 0.0f, -(MESH_TOTAL_SIZE / 2.0f)));
+
+		startTime = (float)glfwGetTime();
+
+		// Render Prep Pass: pack the height, normal and color factors of every texel for the render shaders,
+		// and rebuild the height bounds of the level of detail patches or the max heights of the ray marcher
+		if (isRenderDataChanged) {
+			renderPrepComputeShader.use();
+			// Link renderDataTextureID to the output (binding = 0) of the render prep shader
+			glBindImageTexture(0, renderDataTextureID, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA32UI);
+			// Link renderCDTextureID to binding = 1 in the render prep shader
+			glBindImageTexture(1, renderCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+			// Link renderWTextureID to binding = 2 in the render prep shader
+			glBindImageTexture(2, renderWTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+
+			glDispatchCompute(NUM_GROUPS_X, NUM_GROUPS_Y, 1);
+			// Make the render data visible to the texture fetches of the render shaders
+			glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+			if (isRayMarchedRender) {
+				heightfieldRayMarcher.UpdateMaxHeights(rayMarchMaxHeightComputeShader, rayMarchMaxHeightReductionComputeShader, renderDataTextureID);
+			}
+			else {
+				chunkedTerrain.UpdateHeightBounds(heightBoundsComputeShader, heightBoundsReductionComputeShader, renderCDTextureID, renderWTextureID);
+			}
+		}
+
+		glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+		if (isRayMarchedRender) {
+			glm::mat4 modelViewProjection = projection * view * model;
+
+			// activate heightfield ray march shader
+			heightfieldRayMarchShader.use();
+			// set shader properties
+			heightfieldRayMarchShader.setVec3("viewPos", camera.Position);
+			heightfieldRayMarchShader.setInt("renderDataTexture", 0);
+
+			heightfieldRayMarchShader.setMat4("model", model);
+			heightfieldRayMarchShader.setMat4("modelViewProjection", modelViewProjection);
+			heightfieldRayMarchShader.setMat4("inverseModelViewProjection", glm::inverse(modelViewProjection));
+			heightfieldRayMarchShader.setMat3("normalMatrix", normalMatrix);
+
+			// bind texture
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, renderDataTextureID);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, detailNoiseTextureID);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, heightfieldRayMarcher.MaxHeightTextureID);
+
+			// ray march the terrain and water
+			heightfieldRayMarcher.Draw();
+		}
+		else {
+			// Pick the level of detail patches for the eye, which the movie mode places apart from the camera
+			glm::vec3 lodCenter = glm::vec3(glm::inverse(view * model)[3]);
+			chunkedTerrain.Select(lodCenter, glm::radians(camera.Zoom), (float)renderHeight, LOD_PIXEL_ERROR);
+
+			// Cull the picked patches against the view frustum
+			chunkedTerrain.Cull(patchCullingComputeShader, projection * view * model);
+
+			// activate terrain render shader
+			terrainRenderShader.use();
+			// set shader properties
+			terrainRenderShader.setVec3("viewPos", camera.Position);
+			terrainRenderShader.setInt("renderDataTexture", 0);
+		
+			terrainRenderShader.setMat4("projection", projection);		
+			terrainRenderShader.setMat4("view", view);				
+			terrainRenderShader.setMat4("model", model);
+			terrainRenderShader.setMat3("normalMatrix", normalMatrix);
+			terrainRenderShader.setVec3("lodCenter", lodCenter);
+			chunkedTerrain.SetMorphRanges(terrainRenderShader);
+		
+			// bind texture
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, renderDataTextureID);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, detailNoiseTextureID);
+
+			// render mesh
+			chunkedTerrain.Draw(TERRAIN_DRAW);
+
+			// activate water render shader
+			waterRenderShader.use();
+			// set shader properties
+			waterRenderShader.setVec3("viewPos", camera.Position);
+			waterRenderShader.setInt("renderDataTexture", 0);
+
+			waterRenderShader.setMat4("projection", projection);
+			waterRenderShader.setMat4("view", view);
+			waterRenderShader.setMat4("model", model);
+			waterRenderShader.setMat3("normalMatrix", normalMatrix);
+			waterRenderShader.setVec3("lodCenter", lodCenter);
+			chunkedTerrain.SetMorphRanges(waterRenderShader);
+
+			// bind texture
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, renderDataTextureID);
+
+			// render mesh
+			chunkedTerrain.Draw(WATER_DRAW);
+		}
+
+		// Record the frame, the flythrough ends at the last keyframe of its path
+		if (isOfflineFlythrough) {
+			frameRecorder.CaptureFrame();
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			if (simulationTime >= flythroughPath.EndTime()) {
+				glfwSetWindowShouldClose(window, true);
+			}
+		}
+		// Upscale the scene to the window
+		else if (isDynamicRenderResolution) {
+			int windowWidth, windowHeight;
+			glfwGetFramebufferSize(window, &windowWidth, &windowHeight);
+
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFramebufferID);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+			glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, windowWidth, windowHeight);
+		}
+
+		endTime = (float)glfwGetTime();
+		frameMetrics.RenderTime = endTime - startTime;
+		metricsReporter.Record(frameMetrics);
+		cycleCount++;
+
+		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+		// -------------------------------------------------------------------------------
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+	}
+
+	metricsReporter.Stop();
+
+	if (inputLog.IsRecording || inputLog.IsReplaying) {
+		inputLog.Close();
+	}
+
+	if (isStateExportedOnExit && processRank == 0) {
+		ExportState(simulationStep);
+	}
+
+	// Write out the frames still being read back
+	if (isOfflineFlythrough && processRank == 0) {
+		frameRecorder.Finish();
+		frameRecorder.Delete();
+	}
+
+	// Let the other processes of a multi-process run leave their render loop before the shared memory is removed
+	if (isMultiProcess) {
+		if (processRank == 0) {
+			stripDomain.SynchronizeFrame(deltaTime, simulationStepsPerFrame, true);
+		}
+		stripDomain.Communicator.Finalize();
+	}
+
+	// Deallocate all opengl resources
+	// -----------------------------------------------------------
+	chunkedTerrain.Delete();
+	if (isRayMarchedRender) {
+		heightfieldRayMarcher.Delete();
+	}
+	glDeleteProgram(waterIncrementComputeShader.ID);
+	glDeleteProgram(fluxUpdateComputeShader.ID);
+	//glDeleteProgram(waterHeightUpdateComputeShader.ID);
+	glDeleteProgram(velocityFieldUpdateComputeShader.ID);
+	glDeleteProgram(soilFlowComputeShader.ID);
+	glDeleteProgram(sedimentErosionAndDepositionComputeShader.ID);
+	glDeleteProgram(sedimentTransportationComputeShader.ID);
+	glDeleteProgram(soilFlowDepositionComputeShader.ID);
+	glDeleteProgram(evaporationComputeShader.ID);
+	glDeleteProgram(terrainRenderShader.ID);
+	glDeleteProgram(swapBuffersComputeShader.ID);
+	glDeleteProgram(tileActivityComputeShader.ID);
+	glDeleteProgram(tileCompactionComputeShader.ID);
+	glDeleteBuffers(1, &tileActivityBufferID);
+	glDeleteBuffers(1, &activeTilesBufferID);
+	glDeleteProgram(maxReductionComputeShader.ID);
+	glDeleteProgram(heightBoundsComputeShader.ID);
+	glDeleteProgram(heightBoundsReductionComputeShader.ID);
+	glDeleteProgram(patchCullingComputeShader.ID);
+	glDeleteProgram(renderPrepComputeShader.ID);
+	glDeleteProgram(rayMarchMaxHeightComputeShader.ID);
+	glDeleteProgram(rayMarchMaxHeightReductionComputeShader.ID);
+	glDeleteProgram(heightfieldRayMarchShader.ID);
+	glDeleteTextures(1, &renderDataTextureID);
+	glDeleteTextures(1, &detailNoiseTextureID);
+	if (isDynamicRenderResolution) {
+		glDeleteFramebuffers(1, &sceneFramebufferID);
+		glDeleteRenderbuffers(1, &sceneColorRenderbufferID);
+		glDeleteRenderbuffers(1, &sceneDepthRenderbufferID);
+	}
+	glDeleteBuffers(1, &maxReductionBufferID);
+	if (maxReductionFence != 0) {
+		glDeleteSync(maxReductionFence);
+	}
+	if (isTiledDomain) {
+		glDeleteBuffers(2, tiledDomain.UploadBufferIDs);
+		glDeleteBuffers(2, tiledDomain.ReadBackBufferIDs);
+	}
+
+	// glfw: terminate, clearing all previously allocated GLFW resources.
+	// ------------------------------------------------------------------
+	glfwTerminate();
+	return 0;
+}
+
+// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
+// ---------------------------------------------------------------------------------------------------------
+void processInput(GLFWwindow *window)
+{
+	// The keys and events of a replayed frame come from the log, those of a recorded one go to it
+	if (!inputLog.IsReplaying) {
+		inputFrame.Keys = 0;
+		for (unsigned int i = 0; i < sizeof(INPUT_KEYS) / sizeof(INPUT_KEYS[0]); i++) {
+			if (glfwGetKey(window, INPUT_KEYS[i]) == GLFW_PRESS) {
+				inputFrame.Keys |= 1 << i;
+			}
+		}
+	}
+	if (inputLog.IsRecording) {
+		inputLog.Write(inputFrame);
+	}
+
+	for (const InputEvent &event : inputFrame.Events) {
+		if (event.Type == INPUT_MOUSE_MOVE) {
+			ApplyMouseMove(event.X, event.Y);
+		}
+		else {
+			ApplyScroll(event.Y);
+		}
+	}
+	inputFrame.Events.clear();
+
+	if (IsKeyPressed(GLFW_KEY_ESCAPE))
+		glfwSetWindowShouldClose(window, true);
+
+	if (!isMovieMode) {
+		if (IsKeyPressed(GLFW_KEY_W)) {
+			camera.ProcessKeyboard(FORWARD, deltaTime);
+		}
+		if (IsKeyPressed(GLFW_KEY_S)) {
+			camera.ProcessKeyboard(BACKWARD, deltaTime);
+		}
+		if (IsKeyPressed(GLFW_KEY_A)) {
+			camera.ProcessKeyboard(LEFT, deltaTime);
+		}
+		if (IsKeyPressed(GLFW_KEY_D)) {
+			camera.ProcessKeyboard(RIGHT, deltaTime);
+		}
+		if (IsKeyPressed(GLFW_KEY_SPACE)) {
+			float currentPressTime = inputFrame.Time;
+
+			if (currentPressTime - spaceLastPressTime > KEY_PRESS_DELAY) {
+				spaceLastPressTime = currentPressTime;
+				isSimulationPaused = !isSimulationPaused;
+			}
+		}
+		if (IsKeyPressed(GLFW_KEY_P)) {
+			float currentPressTime = inputFrame.Time;
+
+			if (currentPressTime - pLastPressTime > KEY_PRESS_DELAY) {
+				pLastPressTime = currentPressTime;
+				drawPolygon = !drawPolygon;
+				if (drawPolygon) {
+					glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+				}
+				else {
+					glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+				}
+			}
+		}
+		if (IsKeyPressed(GLFW_KEY_E)) {
+			float currentPressTime = inputFrame.Time;
+
+			if (currentPressTime - eLastPressTime > KEY_PRESS_DELAY) {
+				eLastPressTime = currentPressTime;
+				isStateExportRequested = true;
+			}
+		}
+	}
+}
+
+bool IsKeyPressed(int key) {
+	for (unsigned int i = 0; i < sizeof(INPUT_KEYS) / sizeof(INPUT_KEYS[0]); i++) {
+		if (INPUT_KEYS[i] == key) {
+			return (inputFrame.Keys >> i) & 1;
+		}
+	}
+	return false;
+}
+
+// glfw: whenever the window size changed (by OS or user resize) this callback function executes
+// ---------------------------------------------------------------------------------------------
+void framebuffer_size_callback(GLFWwindow* window, int width, int height)
+{
+	// make sure the viewport matches the new window dimensions; note that width and 
+	// height will be significantly larger than specified on retina displays.
+	glViewport(0, 0, width, height);
+}
+
+
+// glfw: whenever the mouse moves, this callback is called
+// -------------------------------------------------------
+void mouse_callback(GLFWwindow* window, double xpos, double ypos)
+{
+	// Applied by the next processInput, a replayed session only takes the events of its log
+	if (!inputLog.IsReplaying) {
+		inputFrame.Events.push_back({ INPUT_MOUSE_MOVE, (float)xpos, (float)ypos });
+	}
+}
+
+// glfw: whenever the mouse scroll wheel scrolls, this callback is called
+// ----------------------------------------------------------------------
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+	if (!inputLog.IsReplaying) {
+		inputFrame.Events.push_back({ INPUT_SCROLL, 0.0f, (float)yoffset });
+	}
+}
+
+void ApplyMouseMove(float xpos, float ypos)
+{
+	if (firstMouse)
+	{
+		lastX = xpos;
+		lastY = ypos;
+		firstMouse = false;
+	}
+
+	float xoffset = xpos - lastX;
+	float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
+
+	lastX = xpos;
+	lastY = ypos;
+
+	if (!isMovieMode) {
+		camera.ProcessMouseMovement(xoffset, yoffset);
+	}
+}
+
+void ApplyScroll(float yoffset)
+{
+	if (!isMovieMode) {
+		camera.ProcessMouseScroll(yoffset);
+	}
+}
+
+void GenerateMeshTextures(unsigned int width, unsigned int height) {
+	// create texture for initial terrain data, which is generated once every texture exists
+	CDTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, false);
+
+	// create textures for initial water data, flux, velocity, regolith flux, sediment flux (Left, Right, Top, Bottom) and
+	// sediment corner flux (Bottom Left, Bottom Right, Top Left, Top Right), which all start at zero
+	WTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	FTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	VTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	RTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	STextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	SCTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+
+	// create textures for terrain data, water data, flux, velocity, regolith flux, sediment flux and sediment corner flux output
+	// The flux, velocity and regolith flux outputs start at zero as well, the active tile passes leave the texels of skipped tiles as they are
+	tempCDTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, false);
+	tempWTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, false);
+	tempFTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	tempVTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	tempRTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, true);
+	tempSTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, false);
+	tempSCTextureID = GenerateDataTexture(MESH_WIDTH, MESH_HEIGHT, false);
+
+	float generationStartTime = (float)glfwGetTime();
+
+	// Everything the initial column data is generated from
+	InitialStateKey initialStateKey;
+	initialStateKey.Add(INITIAL_STATE_CACHE_VERSION);
+	initialStateKey.Add(width);
+	initialStateKey.Add(height);
+	initialStateKey.Add(isSquarePillarTerrain);
+	initialStateKey.Add(isSphereTerrain);
+	initialStateKey.Add(isGPUTerrainGeneration);
+	initialStateKey.Add(terrainSeed);
+	initialStateKey.Add(vegetationSeed);
+	initialStateKey.Add(maxVegetationValue);
+	initialStateKey.Add(isVegetation);
+	initialStateKey.Add(isVegetationSeed);
+	initialStateKey.Add(HEIGHT_SCALING_VALUE);
+
+	// Imported terrain is read from its rasters every run and never cached
+	InitialStateCache initialStateCache(INITIAL_STATE_CACHE_DIRECTORY);
+	bool isCachedStateLoaded = isInitialStateCached && !isImportedTerrain && initialStateCache.Load(initialStateKey, CDTextureID, width, height);
+
+	if (isCachedStateLoaded) {
+		cout << "Initial State Cache: " << initialStateCache.Path(initialStateKey) << endl;
+	}
+	else if (isImportedTerrain && ImportTerrain(width, height)) {
+		cout << "Imported Terrain: " << DEM_PATH << endl;
+	}
+	else if (isGPUTerrainGeneration) {
+		GenerateTerrainOnGPU(width, height);
+	}
+	else {
+		// The host generates into CDTexture, which is only allocated for the upload
+		CDTexture.resize(width * height * 4);
+
+		if (isSquarePillarTerrain) {
+			GenerateSquarePillar(width, height);
+		}
+		else if (isSphereTerrain) {
+			GenerateSphere(width, height);
+		}
+		else {
+			GenerateBaseTextures(width, height);
+		}
+
+		glBindTexture(GL_TEXTURE_2D, CDTextureID);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, MESH_WIDTH, MESH_HEIGHT, TEXTURE_FORMAT, GL_FLOAT, &CDTexture[0]);
+		vector<float>().swap(CDTexture);
+	}
+
+	if (isInitialStateCached && !isImportedTerrain && !isCachedStateLoaded) {
+		initialStateCache.Store(initialStateKey, CDTextureID, width, height);
+	}
+
+	cout << "Terrain Gen Time: " << (float)glfwGetTime() - generationStartTime << endl;
+}
+
+void GenerateTerrainOnGPU(unsigned int width, unsigned int height) {
+	// FastNoise permutation tables of the terrain and vegetation seeds (binding = 7)
+	FastNoise terrainNoise;
+	terrainNoise.SetSeed(terrainSeed);
+	FastNoise vegetationNoise;
+	vegetationNoise.SetSeed(vegetationSeed);
+
+	vector<GLuint> permutations(512);
+	for (unsigned int i = 0; i < 256; i++) {
+		permutations[i] = terrainNoise.GetPermutation()[i];
+		permutations[i + 256] = vegetationNoise.GetPermutation()[i];
+	}
+
+	unsigned int permutationBufferID;
+	glGenBuffers(1, &permutationBufferID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, permutationBufferID);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, permutations.size() * sizeof(GLuint), &permutations[0], GL_STATIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, permutationBufferID);
+
+	// The vegetation cover of the Perlin terrain reads the neighbors of every cell, so the terrain is generated into
+	// tempCDTextureID first and covered into CDTextureID
+	bool isVegetationCover = !isSquarePillarTerrain && !isSphereTerrain && isVegetation && !isVegetationSeed;
+
+	// The generation shaders are only needed once
+	Shader terrainGenerationComputeShader("terrainGeneration.ComputeShader");
+	terrainGenerationComputeShader.use();
+	terrainGenerationComputeShader.setBool("isSquarePillarTerrain", isSquarePillarTerrain);
+	terrainGenerationComputeShader.setBool("isSphereTerrain", isSphereTerrain);
+	terrainGenerationComputeShader.setBool("isVegetation", isVegetation);
+	terrainGenerationComputeShader.setBool("isVegetationSeed", isVegetationSeed);
+	terrainGenerationComputeShader.setFloat("noiseFrequency", terrainNoise.GetFrequency());
+	terrainGenerationComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	terrainGenerationComputeShader.setFloat("HEIGHT_SCALING_VALUE", HEIGHT_SCALING_VALUE);
+
+	// Link CDTextureID, or tempCDTextureID before the vegetation cover, to the output (binding = 0) of the terrain generation shader
+	glBindImageTexture(0, isVegetationCover ? tempCDTextureID : CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+	glDispatchCompute((width + WORK_GROUP_SIZE_X - 1) / WORK_GROUP_SIZE_X, (height + WORK_GROUP_SIZE_Y - 1) / WORK_GROUP_SIZE_Y, 1);
+	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+	if (isVegetationCover) {
+		CoverVegetationOnGPU(width, height);
+	}
+
+	glDeleteProgram(terrainGenerationComputeShader.ID);
+	glDeleteBuffers(1, &permutationBufferID);
+
+	// Wait for the generation, so the startup time includes it
+	glFinish();
+}
+
+// Cover the flat ground of the terrain in tempCDTextureID in vegetation, into CDTextureID
+void CoverVegetationOnGPU(unsigned int width, unsigned int height) {
+	// The vegetation cover shader is only needed once
+	Shader vegetationCoverComputeShader("vegetationCover.ComputeShader");
+	vegetationCoverComputeShader.use();
+	vegetationCoverComputeShader.setFloat("maxVegetationValue", maxVegetationValue);
+	vegetationCoverComputeShader.setFloat("MAX_HEIGHT_DIFFERENCE", (0.06f * 256.0f / MESH_WIDTH) / HEIGHT_SCALING_VALUE);
+
+	// Link CDTextureID to the output (binding = 0) of the vegetation cover shader
+	glBindImageTexture(0, CDTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, INTERNAL_TEXTURE_FORMAT);
+	// Link tempCDTextureID to binding = 1 in the vegetation cover shader
+	glBindImageTexture(1, tempCDTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, INTERNAL_TEXTURE_FORMAT);
+	glDispatchCompute((width + WORK_GROUP_SIZE_X - 1) / WORK_GROUP_SIZE_X, (height + WORK_GROUP_SIZE_Y - 1) / WORK_GROUP_SIZE_Y, 1);
+	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+	glDeleteProgram(vegetationCoverComputeShader.ID);
+}
+
+// Fill CDTextureID from the elevation raster, and the land cover raster when there is one, streaming blocks of rows to the texture
+bool ImportTerrain(unsigned int width, unsigned int height) {
+	RasterReader elevationReader;
+	if (!elevationReader.Open(DEM_PATH, DEM_RAW_SAMPLE_TYPE, DEM_RAW_WIDTH, DEM_RAW_HEIGHT)) {
+		return false;
+	}
+	RasterResampler elevationResampler(elevationReader, width, height, false, DEM_NO_DATA_VALUE);
+
+	bool isLandCover = LAND_COVER_PATH[0] != '\0';
+	RasterReader landCoverReader;
+	if (isLandCover && !landCoverReader.Open(LAND_COVER_PATH, LAND_COVER_RAW_SAMPLE_TYPE, DEM_RAW_WIDTH, DEM_RAW_HEIGHT)) {
+		return false;
+	}
+	RasterResampler landCoverResampler(landCoverReader, width, height, true, -1.0f);
+
+	// Without a land cover raster the flat ground is covered in vegetation, as on the generated terrain
+	bool isVegetationCover = isVegetation && !isLandCover;
+
+	const unsigned int IMPORT_ROW_BLOCK = 64;
+	vector<float> elevationRow(width);
+	vector<float> landCoverRow(width, -1.0f);
+	vector<float> blockData(width * IMPORT_ROW_BLOCK * 4, 0.0f);
+
+	glBindTexture(GL_TEXTURE_2D, isVegetationCover ? tempCDTextureID : CDTextureID);
+	for (unsigned int firstRow = 0; firstRow < height; firstRow += IMPORT_ROW_BLOCK) {
+		unsigned int blockRows = min(IMPORT_ROW_BLOCK, height - firstRow);
+
+		for (unsigned int j = 0; j < blockRows; j++) {
+			if (!elevationResampler.ReadGridRow(&elevationRow[0]) || (isLandCover && !landCoverResampler.ReadGridRow(&landCoverRow[0]))) {
+				return false;
+			}
+
+			for (unsigned int i = 0; i < width; i++) {
+				float terrainValue = elevationRow[i] * DEM_HEIGHT_SCALE + DEM_HEIGHT_OFFSET;
+
+				float vegetationValue = 0.0f;
+				if (isVegetation) {
+					for (size_t c = 0; c < sizeof(LAND_COVER_VEGETATION) / sizeof(LAND_COVER_VEGETATION[0]); c++) {
+						if (landCoverRow[i] == LAND_COVER_VEGETATION[c].LandCoverClass) {
+							vegetationValue = LAND_COVER_VEGETATION[c].VegetationFraction * maxVegetationValue;
+						}
+					}
+				}
+
+				// See CDTexture for the channels, the column height is the elevation
+				blockData[(i + j * width) * 4 + 2] = vegetationValue;
+				blockData[(i + j * width) * 4 + 3] = terrainValue - vegetationValue;
+			}
+		}
+
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, blockRows, TEXTURE_FORMAT, GL_FLOAT, &blockData[0]);
+	}
+
+	if (isVegetationCover) {
+		CoverVegetationOnGPU(width, height);
+	}
+
+	return true;
+}
+
+// Write the rendered column data and water textures of the step in STATE_EXPORT_FORMAT
+void ExportState(unsigned int step) {
+	const char *const CD_CHANNEL_NAMES[4] = { "water", "regolith", "vegetation", "terrain" };
+	const char *const W_CHANNEL_NAMES[4] = { "sediment", "deadVegetationSediment", "timeCoveredInWater", "deadVegetationHeight" };
+
+	char prefix[256];
+	snprintf(prefix, sizeof(prefix), "%s_%06u", STATE_EXPORT_PREFIX, step);
+
+	RasterExporter exporter(STATE_EXPORT_FORMAT);
+	if (exporter.Export(renderCDTextureID, MESH_WIDTH, MESH_HEIGHT, string(prefix) + "_CD", CD_CHANNEL_NAMES) &&
+		exporter.Export(renderWTextureID, MESH_WIDTH, MESH_HEIGHT, string(prefix) + "_W", W_CHANNEL_NAMES)) {
+		cout << "State Exported: " << prefix << endl;
+	}
+}
+
+void SetWaterSources(Shader &shader, unsigned int width, unsigned int height) {
+	shader.setInt("currentNumberSources", 2);
+	if (isSphereTerrain) {
+		// Source 1
+		shader.setIVec2("sources[0].position", (int)(0.45f * width), (int)(0.45f * height));
+		shader.setInt("sources[0].radius", width / 80);
+		shader.setFloat("sources[0].Kis", 0.3f);
+		// Source 2
+		shader.setIVec2("sources[1].position", (int)(0.65f * width), (int)(0.65f * height));
+		shader.setInt("sources[1].radius", width / 80);
+		shader.setFloat("sources[1].Kis", 0.3f);
+	}
+	else {
+		// Source 1
+		shader.setIVec2("sources[0].position", (int)(0.25f * width), (int)(0.25f * height));
+		shader.setInt("sources[0].radius", width / 20);
+		shader.setFloat("sources[0].Kis", 0.5f);
+		// Source 2
+		shader.setIVec2("sources[1].position", (int)(0.75f * width), (int)(0.75f * height));
+		shader.setInt("sources[1].radius", width / 40);
+		shader.setFloat("sources[1].Kis", 0.75f);
+	}
+}
+
+void GenerateActiveTileBuffers() {
+	vector<GLuint> activeTilesData(3 + NUM_TILES_X * NUM_TILES_Y, 0);
+
+	// Start with every tile active, the first step runs the whole grid on this list before any activity pass (see the render loop)
+	activeTilesData[0] = NUM_TILES_X * NUM_TILES_Y;
+	activeTilesData[1] = 1;
+	activeTilesData[2] = 1;
+	for (unsigned int j = 0; j < NUM_TILES_Y; j++) {
+		for (unsigned int i = 0; i < NUM_TILES_X; i++) {
+			activeTilesData[3 + i + j * NUM_TILES_X] = i | (j << 16);
+		}
+	}
+
+	// create buffer for the per tile activity mask (binding = 0)
+	glGenBuffers(1, &tileActivityBufferID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, tileActivityBufferID);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, NUM_TILES_X * NUM_TILES_Y * sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, tileActivityBufferID);
+
+	// create buffer for the indirect dispatch arguments followed by the active tile list (binding = 1)
+	glGenBuffers(1, &activeTilesBufferID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, activeTilesBufferID);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, activeTilesData.size() * sizeof(GLuint), &activeTilesData[0], GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, activeTilesBufferID);
+	glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, activeTilesBufferID);
+}
+
+// Dispatch a hydraulic pass over the active tile list, or over the whole grid when scheduling is off
+void DispatchHydraulicPass() {
+	if (isActiveTileScheduling) {
+		glDispatchComputeIndirect(0);
+	}
+	else {
+		glDispatchCompute(simulationGroupsX, simulationGroupsY, NUM_GROUPS_Z);
+	}
+}
+
+void GenerateRenderDataTexture(unsigned int width, unsigned int height) {
+	// create the render data texture array, a terrain layer and a water surface layer (see renderPrep.ComputeShader)
+	// The render shaders sample it at the texels the nearest filtered simulation textures were sampled at
+	glGenTextures(1, &renderDataTextureID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, renderDataTextureID);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA32UI, width, height, 2, 0, GL_RGBA_INTEGER, GL_UNSIGNED_INT, NULL);
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+void GenerateSceneFramebuffer(unsigned int width, unsigned int height) {
+	// create the scene framebuffer, sized for the largest render scale, a smaller scale only draws to its lower left corner
+	glGenFramebuffers(1, &sceneFramebufferID);
+	glGenRenderbuffers(1, &sceneColorRenderbufferID);
+	glGenRenderbuffers(1, &sceneDepthRenderbufferID);
+
+	glBindRenderbuffer(GL_RENDERBUFFER, sceneColorRenderbufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, sceneDepthRenderbufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, sceneFramebufferID);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, sceneColorRenderbufferID);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, sceneDepthRenderbufferID);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		cout << "ERROR::FRAMEBUFFER::SCENE_FRAMEBUFFER_NOT_COMPLETE" << endl;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void GenerateDetailNoiseTexture(unsigned int size) {
+	// create the mip mapped detail noise texture over the terrain render texture coordinates
+	unsigned int levels = 1;
+	while ((size >> levels) > 0) {
+		levels++;
+	}
+
+	glGenTextures(1, &detailNoiseTextureID);
+	glBindTexture(GL_TEXTURE_2D, detailNoiseTextureID);
+	glTexStorage2D(GL_TEXTURE_2D, levels, GL_RG16F, size, size);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// The bake shader is only needed once
+	Shader detailNoiseComputeShader("detailNoise.ComputeShader");
+	detailNoiseComputeShader.use();
+	detailNoiseComputeShader.setFloat("baseTerrainFrequency", baseTerrainFrequency);
+	detailNoiseComputeShader.setFloat("baseTerrainAmplitude", baseTerrainAmplitude);
+	detailNoiseComputeShader.setFloat("baseGrassFrequency", baseGrassFrequency);
+	detailNoiseComputeShader.setFloat("baseGrassAmplitude", baseGrassAmplitude);
+
+	// Link detailNoiseTextureID to the output (binding = 0) of the detail noise shader
+	glBindImageTexture(0, detailNoiseTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+	glDispatchCompute((size + WORK_GROUP_SIZE_X - 1) / WORK_GROUP_SIZE_X, (size + WORK_GROUP_SIZE_Y - 1) / WORK_GROUP_SIZE_Y, 1);
+	// Make the noise visible to the mip map generation and the texture fetches of the terrain render shader
+	glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glDeleteProgram(detailNoiseComputeShader.ID);
+}
+
+void GenerateMaxReductionBuffer() {
+	// create buffer for the max water velocity and max water depth (binding = 2)
+	glGenBuffers(1, &maxReductionBufferID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, maxReductionBufferID);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * sizeof(GLuint), NULL, GL_DYNAMIC_READ);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, maxReductionBufferID);
+}
+
+// Largest time step for which neither the flow nor a gravity wave crosses more than CFL_NUMBER pipes per step
+float ComputeStableTimeStep(float maxVelocity, float maxWaterDepth, float previousTimeStep) {
+	// Heights are scaled by 256 in the flux update, so the wave speed uses the same scaled depth
+	float waveSpeed = sqrt(g * 256.0f * maxWaterDepth);
+	float signalSpeed = maxVelocity + waveSpeed;
+	float newTimeStep = MAX_TIME_STEP;
+
+	if (signalSpeed > 0) {
+		newTimeStep = CFL_NUMBER * PIPE_LENGTH / signalSpeed;
+	}
+
+	// Only grow gradually, the reduction lags a few steps behind so a rising flood must not outrun it
+	newTimeStep = min(newTimeStep, previousTimeStep * MAX_TIME_STEP_GROWTH);
+
+	return glm::clamp(newTimeStep, MIN_TIME_STEP, MAX_TIME_STEP);
+}
+
+void GenerateCoarseTextures(unsigned int width, unsigned int height) {
+	// create textures for the coarse column data, water data, flux and regolith flux (see GenerateMeshTextures)
+	coarseCDTextureID = GenerateDataTexture(width, height, true);
+	coarseWTextureID = GenerateDataTexture(width, height, true);
+	coarseFTextureID = GenerateDataTexture(width, height, true);
+	coarseRTextureID = GenerateDataTexture(width, height, true);
+
+	// create textures for the coarse outputs
+	tempCoarseCDTextureID = GenerateDataTexture(width, height, false);
+	tempCoarseWTextureID = GenerateDataTexture(width, height, false);
+	tempCoarseFTextureID = GenerateDataTexture(width, height, false);
+	tempCoarseRTextureID = GenerateDataTexture(width, height, false);
+}
+
+// Immutable storage of a data texture, cleared to zero on the GPU when isCleared, otherwise left for the passes to fill
+unsigned int GenerateDataTexture(unsigned int width, unsigned int height, bool isCleared) {
+	unsigned int textureID;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	glTexStorage2D(GL_TEXTURE_2D, 1, INTERNAL_TEXTURE_FORMAT, width, height);
+	if (isCleared) {
+		glClearTexImage(textureID, 0, TEXTURE_FORMAT, GL_FLOAT, NULL);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	return textureID;
+}
+
+void GenerateTiledDomainTextures(unsigned int width, unsigned int height) {
+	// The full size temp column data and water data textures are kept to render the domain preview
+	unsigned int meshTextureIDs[12] = { CDTextureID, WTextureID, FTextureID, VTextureID, RTextureID, STextureID, SCTextureID, tempFTextureID, tempVTextureID, tempRTextureID, tempSTextureID, tempSCTextureID };
+	glDeleteTextures(12, meshTextureIDs);
+
+	// create the simulation textures at the size of the largest tile region, the tiles upload their own data
+	CDTextureID = GenerateDataTexture(width, height, false);
+	WTextureID = GenerateDataTexture(width, height, false);
+	FTextureID = GenerateDataTexture(width, height, false);
+	VTextureID = GenerateDataTexture(width, height, false);
+	RTextureID = GenerateDataTexture(width, height, false);
+	STextureID = GenerateDataTexture(width, height, false);
+	SCTextureID = GenerateDataTexture(width, height, false);
+	tempCDTextureID = GenerateDataTexture(width, height, false);
+	tempWTextureID = GenerateDataTexture(width, height, false);
+	tempFTextureID = GenerateDataTexture(width, height, false);
+	tempVTextureID = GenerateDataTexture(width, height, false);
+	tempRTextureID = GenerateDataTexture(width, height, false);
+	tempSTextureID = GenerateDataTexture(width, height, false);
+	tempSCTextureID = GenerateDataTexture(width, height, false);
+}
+
+// Cut the simulation textures down to the rows of a strip, the full size temp column data and water data textures are kept for rendering
+void GenerateStripTextures(unsigned int firstRow, unsigned int height) {
+	unsigned int *meshTextureIDs[14] = { &CDTextureID, &WTextureID, &FTextureID, &VTextureID, &RTextureID, &STextureID, &SCTextureID, &tempCDTextureID, &tempWTextureID, &tempFTextureID, &tempVTextureID, &tempRTextureID, &tempSTextureID, &tempSCTextureID };
+
+	for (int i = 0; i < 14; i++) {
+		unsigned int stripTextureID = GenerateDataTexture(MESH_WIDTH, height, false);
+		glCopyImageSubData(*meshTextureIDs[i], GL_TEXTURE_2D, 0, 0, firstRow, 0, stripTextureID, GL_TEXTURE_2D, 0, 0, 0, 0, MESH_WIDTH, height, 1);
+
+		if (*meshTextureIDs[i] != renderCDTextureID && *meshTextureIDs[i] != renderWTextureID) {
+			glDeleteTextures(1, meshTextureIDs[i]);
+		}
+		*meshTextureIDs[i] = stripTextureID;
+	}
+}
+
+// Generate the base terrain of a tiled domain one tile at a time, with the noise of GenerateBaseTextures at the cell size of the mesh
+// The water data, flux, regolith flux and velocity of every tile start empty
+bool GenerateTiledDomainTerrain(TiledDomain &domain) {
+	FastNoise terrainNoise;
+	terrainNoise.SetNoiseType(FastNoise::Perlin);
+	terrainNoise.SetSeed(terrainSeed);
+
+	FastNoise vegetationNoise;
+	vegetationNoise.SetNoiseType(FastNoise::Perlin);
+	vegetationNoise.SetSeed(vegetationSeed);
+
+	float MAX_HEIGHT_DIFFERENCE = (0.06f * 256.0f / MESH_WIDTH) / HEIGHT_SCALING_VALUE;
+
+	for (unsigned int tile = 0; tile < domain.NumberTiles(); tile++) {
+		TiledDomain::Region interior = domain.TileInterior(tile);
+		vector<float> tileData(interior.width * interior.height * 4 * TILED_DOMAIN_FIELDS, 0.0f);
+
+		// Terrain heights of the interior and a one cell border clamped to the domain, for the slopes of the vegetation
+		unsigned int borderWidth = interior.width + 2;
+		unsigned int borderHeight = interior.height + 2;
+		vector<float> borderICoords(borderWidth);
+		for (unsigned int i = 0; i < borderWidth; i++) {
+			int x = glm::clamp((int)(interior.x + i) - 1, 0, (int)domain.Width - 1);
+			borderICoords[i] = (float)x * 128 / MESH_WIDTH;
+		}
+		vector<float> borderJCoords(borderHeight);
+		for (unsigned int j = 0; j < borderHeight; j++) {
+			int y = glm::clamp((int)(interior.y + j) - 1, 0, (int)domain.Height - 1);
+			borderJCoords[j] = (float)y * 128 / MESH_HEIGHT;
+		}
+		vector<float> terrainHeights(borderWidth * borderHeight);
+		BaseTerrainNoiseSet(terrainNoise, borderICoords, borderJCoords, &terrainHeights[0]);
+
+		vector<float> vegetationHeights(interior.width * interior.height);
+		if (isVegetation && isVegetationSeed) {
+			vector<float> iCoords(interior.width);
+			for (unsigned int i = 0; i < interior.width; i++) {
+				iCoords[i] = (float)(interior.x + i) * 128 / MESH_WIDTH;
+			}
+			vector<float> jCoords(interior.height);
+			for (unsigned int j = 0; j < interior.height; j++) {
+				jCoords[j] = (float)(interior.y + j) * 128 / MESH_HEIGHT;
+			}
+			BaseVegetationNoiseSet(vegetationNoise, iCoords, jCoords, &vegetationHeights[0]);
+		}
+
+		for (unsigned int j = 0; j < interior.height; j++) {
+			for (unsigned int i = 0; i < interior.width; i++) {
+				unsigned int location = (i + j * interior.width) * 4;
+				unsigned int border = (i + 1) + (j + 1) * borderWidth;
+				float vegetationValue = 0;
+
+				if (isVegetation) {
+					if (isVegetationSeed) {
+						vegetationValue = vegetationHeights[i + j * interior.width];
+					}
+					else {
+						// Flat ground is covered in vegetation, see GenerateBaseTextures
+						float lrHeightDifference = abs(terrainHeights[border - 1] - terrainHeights[border + 1]);
+						float tbHeightDifference = abs(terrainHeights[border + borderWidth] - terrainHeights[border - borderWidth]);
+						float totalHeightDifference = lrHeightDifference + tbHeightDifference;
+
+						if (totalHeightDifference < MAX_HEIGHT_DIFFERENCE) {
+							vegetationValue = maxVegetationValue * min(1.0f, ((MAX_HEIGHT_DIFFERENCE - totalHeightDifference) / MAX_HEIGHT_DIFFERENCE) + 0.4f);
+						}
+					}
+				}
+
+				// Column data is the first field of a tile, see CDTexture for its channels
+				tileData[location + 2] = vegetationValue;
+				tileData[location + 3] = terrainHeights[border] - vegetationValue;
+			}
+		}
+
+		if (!domain.StoreTile(tile, &tileData[0])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Four octaves of Perlin noise making up the base terrain height, over the grid of the coordinates row by row
+void BaseTerrainNoiseSet(FastNoise &terrainNoise, const vector<float> &iCoords, const vector<float> &jCoords, float *noiseSet) {
+	float terrainFrequencyScale = 2;
+	const float terrainOctaveAmplitudes[4] = { 1.0f, 0.5f, 0.25f, 0.125f };
+	OctaveNoiseSet(terrainNoise, iCoords, jCoords, terrainFrequencyScale, terrainOctaveAmplitudes, 4, noiseSet);
+
+	for (size_t cell = 0; cell < iCoords.size() * jCoords.size(); cell++) {
+		noiseSet[cell] /= HEIGHT_SCALING_VALUE;
+	}
+}
+
+// Three octaves of Perlin noise making up the seeded vegetation height, over the grid of the coordinates row by row
+void BaseVegetationNoiseSet(FastNoise &vegetationNoise, const vector<float> &iCoords, const vector<float> &jCoords, float *noiseSet) {
+	float vegetationFrequencyScale = 4;
+	const float vegetationOctaveAmplitudes[3] = { 3.0f, 1.5f, 0.75f };
+	OctaveNoiseSet(vegetationNoise, iCoords, jCoords, vegetationFrequencyScale, vegetationOctaveAmplitudes, 3, noiseSet);
+
+	for (size_t cell = 0; cell < iCoords.size() * jCoords.size(); cell++) {
+		float vegetationNoiseValue = max(0.0f, noiseSet[cell]);
+		vegetationNoiseValue /= HEIGHT_SCALING_VALUE;
+
+		noiseSet[cell] = min(maxVegetationValue, vegetationNoiseValue);
+	}
+}
+
+// Sum of the octaves of the noise over the grid of the coordinates, octave k at frequencyScale * 2^k weighted by octaveAmplitudes[k]
+// Each octave is filled as one noise set, so the noise type is only chosen once per octave
+void OctaveNoiseSet(FastNoise &noise, const vector<float> &iCoords, const vector<float> &jCoords, float frequencyScale, const float *octaveAmplitudes, unsigned int octaves, float *noiseSet) {
+	vector<float> octaveICoords(iCoords.size());
+	vector<float> octaveJCoords(jCoords.size());
+	vector<float> octaveSet(iCoords.size() * jCoords.size());
+
+	float octaveFrequencyScale = frequencyScale;
+	for (unsigned int octave = 0; octave < octaves; octave++) {
+		for (size_t i = 0; i < iCoords.size(); i++) {
+			octaveICoords[i] = octaveFrequencyScale * iCoords[i];
+		}
+		for (size_t j = 0; j < jCoords.size(); j++) {
+			octaveJCoords[j] = octaveFrequencyScale * jCoords[j];
+		}
+
+		noise.FillNoiseSet(&octaveSet[0], &octaveICoords[0], (int)iCoords.size(), &octaveJCoords[0], (int)jCoords.size(), 1, (int)iCoords.size());
+
+		for (size_t cell = 0; cell < octaveSet.size(); cell++) {
+			noiseSet[cell] = octave == 0 ? octaveAmplitudes[octave] * octaveSet[cell] : noiseSet[cell] + octaveAmplitudes[octave] * octaveSet[cell];
+		}
+
+		octaveFrequencyScale *= 2;
+	}
+}
+
+void GenerateBaseTextures(unsigned int width, unsigned int height) {
+	FastNoise terrainNoise;
+	terrainNoise.SetNoiseType(FastNoise::Perlin);
+	terrainNoise.SetSeed(terrainSeed);
+
+	FastNoise vegetationNoise;
+	vegetationNoise.SetNoiseType(FastNoise::Perlin);
+	vegetationNoise.SetSeed(vegetationSeed);
+
+	vector<float> iCoords(width);
+	for (unsigned int i = 0; i < width; i++) {
+		iCoords[i] = (float)i * 128 / MESH_WIDTH;
+	}
+
+	// Every cell only depends on its own noise, so the rows are split between the hardware threads
+	ParallelForRows(height, [&](unsigned int firstRow, unsigned int endRow) {
+		vector<float> jCoords(endRow - firstRow);
+		for (unsigned int j = firstRow; j < endRow; j++) {
+			jCoords[j - firstRow] = (float)j * 128 / MESH_HEIGHT;
+		}
+
+		// The noise of the whole band at once
+		vector<float> terrainNoiseSet(width * jCoords.size());
+		BaseTerrainNoiseSet(terrainNoise, iCoords, jCoords, &terrainNoiseSet[0]);
+
+		vector<float> vegetationNoiseSet(width * jCoords.size(), 0.0f);
+		if (isVegetation) {
+			if (isVegetationSeed) {
+				BaseVegetationNoiseSet(vegetationNoise, iCoords, jCoords, &vegetationNoiseSet[0]);
+			}
+		}
+
+		for (unsigned int j = firstRow; j < endRow; j++) {
+			for (unsigned int i = 0; i < width; i++) {
+				unsigned int location = GetLocation(i, j);
+
+				float terrainNoiseValue = terrainNoiseSet[i + (j - firstRow) * width];
+				float vegetationNoiseValue = vegetationNoiseSet[i + (j - firstRow) * width];
+
+				//////////////////////////////
+				// Initial Column Data Texture (CDTexture)
+				//////////////////////////////
+				// R = water height value
+				// G = regolith height value
+				// B = vegetation height value
+				// A = terrain height value
+				//////////////////////////////
+				CDTexture[location + 0] = 0.0f; 
+				CDTexture[location + 1] = 0.0f; 
+				CDTexture[location + 2] = vegetationNoiseValue;
+				CDTexture[location + 3] = terrainNoiseValue - vegetationNoiseValue;
+		
+				////////////////////////////////////////////////////
+				// All of the textures below are initially empty (0)
+				////////////////////////////////////////////////////
+
+				//////////////////////////////
+				// Initial Water Data Texture (WTexture)
+				//////////////////////////////
+				// R = terrain sediment value
+				// G = dead vegetation sediment value
+				// B = time covered in water value
+				// A = dead vegetation height value
+				//////////////////////////////
+				//////////////////////////////
+				// Initial Flux Texture (FTexture)
+				//////////////////////////////
+				// R = left flux value
+				// G = right flux value
+				// B = top flux value
+				// A = bottom flux value
+				//////////////////////////////
+				//////////////////////////////
+				// Initial Velocity Texture (VTexture)
+				//////////////////////////////
+				// R = velocity in x-direction
+				// G = velocity in y-direction
+				// B = 
+				// A = 
+				//////////////////////////////
+			}
+		}
+	});
+
+	if (isVegetation) {
+		if (!isVegetationSeed) {
+			float MAX_HEIGHT_DIFFERENCE = (0.06f * 256.0f / MESH_WIDTH) / HEIGHT_SCALING_VALUE;
+
+			// Column heights of the noise, the slopes are read from this snapshot while the cells of other threads write theirs
+			vector<float> columnHeights(width * height);
+			ParallelForRows(height, [&](unsigned int firstRow, unsigned int endRow) {
+				for (unsigned int j = firstRow; j < endRow; j++) {
+					for (unsigned int i = 0; i < width; i++) {
+						unsigned int location = GetLocation(i, j);
+						columnHeights[i + j * width] = CDTexture[location + 3] + CDTexture[location + 2];
+					}
+				}
+			});
+
+			// Flat ground is covered in vegetation, every cell only reads the snapshot and writes itself, so the rows are split
+			// between the hardware threads as well
+			ParallelForRows(height, [&](unsigned int firstRow, unsigned int endRow) {
+				for (unsigned int j = firstRow; j < endRow; j++) {
+					for (unsigned int i = 0; i < width; i++) {
+						float vegetationValue = maxVegetationValue;
+
+						// Neighbors past the grid edge are clamped to it
+						float leftHeight = columnHeights[(i > 0 ? i - 1 : 0) + j * width];
+						float rightHeight = columnHeights[min(i + 1, width - 1) + j * width];
+						float topHeight = columnHeights[i + min(j + 1, height - 1) * width];
+						float bottomHeight = columnHeights[i + (j > 0 ? j - 1 : 0) * width];
+
+						float lrHeightDifference = abs(leftHeight - rightHeight);
+						float tbHeightDifference = abs(topHeight - bottomHeight);
+
+						float totalHeightDifference = lrHeightDifference + tbHeightDifference;
+
+						if (totalHeightDifference < MAX_HEIGHT_DIFFERENCE) {
+							float percentage = min(1.0f, ((MAX_HEIGHT_DIFFERENCE - totalHeightDifference) / MAX_HEIGHT_DIFFERENCE) + 0.4f);
+							vegetationValue *= percentage;
+
+							unsigned int location = GetLocation(i, j);
+							CDTexture[location + 2] = vegetationValue;
+							CDTexture[location + 3] -= vegetationValue;
+						}
+					}
+				}
+			});
+		}
+	}
+}
+
+void GenerateSquarePillar(unsigned int width, unsigned int height) {
+	unsigned int location;
+	float terrainValue;
+	float vegetationValue;
+
+	for (unsigned int j = 0; j < height; j++) {
+		for (unsigned int i = 0; i < width; i++) {
+			location = GetLocation(i, j);
+			terrainValue = 0.0f;
+			vegetationValue = 0.0f;
+
+			if (i > width * 0.48f && i < width * 0.52f && j > height * 0.48f && j < height * 0.52f) {
+				if (isVegetation) {
+					vegetationValue = maxVegetationValue;
+				}
+				
+				terrainValue = 0.1f - vegetationValue;
+			}
+			else if (i > width * 0.42f && i < width * 0.46f && j > height * 0.54f && j < height * 0.58f) {
+				if (isVegetation) {
+					vegetationValue = maxVegetationValue;
+				}
+				
+				terrainValue = 0.1f - vegetationValue;
+			}
+			else if (i > width * 0.54f && i < width * 0.58f && j > height * 0.42f && j < height * 0.46f) {
+				if (isVegetation) {
+					vegetationValue = maxVegetationValue;
+				}
+				
+				terrainValue = 0.1f - vegetationValue;
+			}
+
+			//////////////////////////////
+			// Initial Column Data Texture (CDTexture)
+			//////////////////////////////
+			// R = water height value
+			// G = regolith height value
+			// B = vegetation height value
+			// A = terrain height value
+			//////////////////////////////
+			CDTexture[location + 0] = 0.0f;
+			CDTexture[location + 1] = 0.0f;
+			CDTexture[location + 2] = vegetationValue;
+			CDTexture[location + 3] = terrainValue;
+
+			////////////////////////////////////////////////////
+			// All of the textures below are initially empty (0)
+			////////////////////////////////////////////////////
+
+			//////////////////////////////
+			// Initial Water Data Texture (WTexture)
+			//////////////////////////////
+			// R = terrain sediment value
+			// G = dead vegetation sediment value
+			// B = time covered in water value
+			// A = dead vegetation height value
+			//////////////////////////////
+			//////////////////////////////
+			// Initial Flux Texture (FTexture)
+			//////////////////////////////
+			// R = left flux value
+			// G = right flux value
+			// B = top flux value
+			// A = bottom flux value
+			//////////////////////////////
+			//////////////////////////////
+			// Initial Velocity Texture (VTexture)
+			//////////////////////////////
+			// R = velocity in x-direction
+			// G = velocity in y-direction
+			// B = 
+			// A = 
+			//////////////////////////////
+		}
+	}
+}
+
+void GenerateSphere(unsigned int width, unsigned int height) {
+	unsigned int location;
+	float terrainValue;
+	float vegetationValue;
+	int centerX = width / 2;
+	int centerY = height / 2;
+	int cellRadius = width / 3;
+	float heightRadius = 0.1f;
+	int x;
+	int y;
+	float hypotenuse;
+
+	for (unsigned int j = 0; j < height; j++) {
+		for (unsigned int i = 0; i < width; i++) {
+			location = GetLocation(i, j);
+			terrainValue = 0.0f;
+			vegetationValue = 0.0f;
+
+			x = (i - centerX) * (i - centerX);
+			y = (j - centerY) * (j - centerY);
+			hypotenuse = x + y;
+
+			if (hypotenuse <= cellRadius * cellRadius) {
+				float percentage = sqrt(cellRadius * cellRadius - hypotenuse) / cellRadius;
+				if (isVegetation) {
+					vegetationValue = percentage * maxVegetationValue;
+				}
+				terrainValue = percentage * heightRadius - vegetationValue;
+			}
+
+			//////////////////////////////
+			// Initial Column Data Texture (CDTexture)
+			//////////////////////////////
+			// R = water height value
+			// G = regolith height value
+			// B = vegetation height value
+			// A = terrain height value
+			//////////////////////////////
+			CDTexture[location + 0] = 0.0f;
+			CDTexture[location + 1] = 0.0f;
+			CDTexture[location + 2] = vegetationValue;
+			CDTexture[location + 3] = terrainValue;
+
+			////////////////////////////////////////////////////
+			// All of the textures below are initially empty (0)
+			////////////////////////////////////////////////////
+
+			//////////////////////////////
+			// Initial Water Data Texture (WTexture)
+			//////////////////////////////
+			// R = terrain sediment value
+			// G = dead vegetation sediment value
+			// B = time covered in water value
+			// A = dead vegetation height value
+			//////////////////////////////
+			//////////////////////////////
+			// Initial Flux Texture (FTexture)
+			//////////////////////////////
+			// R = left flux value
+			// G = right flux value
+			// B = top flux value
+			// A = bottom flux value
+			//////////////////////////////
+			//////////////////////////////
+			// Initial Velocity Texture (VTexture)
+			//////////////////////////////
+			// R = velocity in x-direction
+			// G = velocity in y-direction
+			// B = 
+			// A = 
+			//////////////////////////////
+		}
+	}
+}
+
+// Run body(firstRow, endRow) on bands of the rows, one band per hardware thread
+void ParallelForRows(unsigned int rows, const function<void(unsigned int, unsigned int)> &body) {
+	unsigned int numberThreads = max(1u, min(rows, thread::hardware_concurrency()));
+
+	vector<thread> threads;
+	for (unsigned int band = 1; band < numberThreads; band++) {
+		threads.push_back(thread(body, rows * band / numberThreads, rows * (band + 1) / numberThreads));
+	}
+	body(0, rows / numberThreads);
+
+	for (size_t band = 0; band < threads.size(); band++) {
+		threads[band].join();
+	}
+}
+
+unsigned int GetLocation(unsigned int i, unsigned int j) {
+	unsigned int x = i;
+	unsigned int y = j;
+
+	if (i < 0) {
+		x = 0;
+	}
+	else if (i >= MESH_WIDTH) {
+		x = MESH_WIDTH - 1;
+	}
+
+	if (j < 0) {
+		y = 0;
+	}
+	else if (j >= MESH_HEIGHT) {
+		y = MESH_HEIGHT - 1;
+	}
+
+	return (x + y * MESH_WIDTH) * 4;
 }
\ No newline at end of file
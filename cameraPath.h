@@ -0,0 +1,66 @@
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include <glm/glm.hpp>
+
+#include "camera.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// A camera position and orientation at a time along a CameraPath, the angles in degrees as Camera takes them
+struct CameraKeyframe {
+	float Time;
+	glm::vec3 Position;
+	float Yaw;
+	float Pitch;
+};
+
+// Scripted camera flight through keyframes ordered by time. Positions and angles follow Catmull-Rom splines through
+// the keyframes, so the camera moves without kinks, and it holds still before the first and after the last keyframe
+class CameraPath {
+public:
+	vector<CameraKeyframe> Keyframes;
+
+	CameraPath(const CameraKeyframe *keyframes, unsigned int count) {
+		Keyframes.assign(keyframes, keyframes + count);
+	}
+
+	float EndTime() const {
+		return Keyframes.back().Time;
+	}
+
+	// Place the camera where the path is at a time
+	void Apply(Camera &camera, float time) const {
+		unsigned int last = Keyframes.size() - 1;
+		time = max(Keyframes[0].Time, min(time, Keyframes[last].Time));
+
+		// Segment from keyframe i to keyframe i + 1, the neighbors outside the path are its end keyframes
+		unsigned int i = 0;
+		while (i + 1 < last && time >= Keyframes[i + 1].Time) {
+			i++;
+		}
+		unsigned int next = min(i + 1, last);
+		float length = Keyframes[next].Time - Keyframes[i].Time;
+		float t = length > 0.0f ? (time - Keyframes[i].Time) / length : 0.0f;
+
+		const CameraKeyframe &k0 = Keyframes[i > 0 ? i - 1 : 0];
+		const CameraKeyframe &k1 = Keyframes[i];
+		const CameraKeyframe &k2 = Keyframes[next];
+		const CameraKeyframe &k3 = Keyframes[min(i + 2, last)];
+
+		camera.Position = CatmullRom(k0.Position, k1.Position, k2.Position, k3.Position, t);
+		camera.SetYawAndPitch(CatmullRom(k0.Yaw, k1.Yaw, k2.Yaw, k3.Yaw, t), CatmullRom(k0.Pitch, k1.Pitch, k2.Pitch, k3.Pitch, t));
+	}
+
+private:
+	template <typename T>
+	static T CatmullRom(const T &p0, const T &p1, const T &p2, const T &p3, float t) {
+		float t2 = t * t;
+		float t3 = t2 * t;
+		return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+	}
+};
+#endif
\ No newline at end of file
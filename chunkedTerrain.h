@@ -0,0 +1,343 @@
+#ifndef CHUNKED_TERRAIN_H
+#define CHUNKED_TERRAIN_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "shader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Most quadtree levels, which the render shaders size their morph range array for
+const unsigned int MAX_LOD_LEVELS = 16;
+// Fraction of a level's range after which its vertices start morphing to the next coarser level
+const float LOD_MORPH_START_RATIO = 0.7f;
+// Shader storage bindings of the visible patches, which the terrain and water render shaders read by instance, of the
+// patches picked for the eye, and of the indirect draw arguments
+const unsigned int PATCHES_BINDING = 3;
+const unsigned int SELECTED_PATCHES_BINDING = 4;
+const unsigned int DRAW_COMMAND_BINDING = 5;
+const unsigned int WATER_PATCHES_BINDING = 6;
+// Indirect draws of the visible patches, the water draw leaves out the dry ones
+const unsigned int TERRAIN_DRAW = 0;
+const unsigned int WATER_DRAW = 1;
+const unsigned int NUMBER_DRAWS = 2;
+// Patches tested by a work group of the patch culling shader
+const unsigned int PATCH_CULLING_GROUP_SIZE = 64;
+
+// Continuous distance-dependent level of detail (CDLOD) for a grid drawn from the simulation textures. A quadtree over the grid
+// picks for every area the coarsest level whose vertex spacing stays under a screen-space error, and every picked node is drawn
+// as instanced patches of one small grid mesh. Vertices morph into the next coarser level over the far end of their level's
+// range, so neighboring levels meet without cracks and switch without popping
+// The render shaders pull a vertex's grid position from its index and its patch from the instance. The picked patches are
+// culled against the view frustum on the GPU, using a pyramid of the lowest and highest height under every patch, and the
+// visible ones are drawn with indirect draws whose instance counts never come back to the CPU. The water draw only gets the
+// patches that hold water, as the pyramid also keeps the deepest water under every patch
+class ChunkedTerrain {
+public:
+	// grid attributes, a vertex for every texel
+	unsigned int GridWidth;
+	unsigned int GridHeight;
+	float CellSize;
+	// Rendered heights lie within [-HeightBound, HeightBound]
+	float HeightBound;
+
+	// Quads along a patch edge, a quadtree node is drawn as four patches
+	unsigned int PatchResolution;
+	unsigned int NumberLevels;
+
+	// Distance up to which each level is drawn, and where it starts morphing to the next coarser level
+	float LevelRanges[MAX_LOD_LEVELS];
+	float MorphStarts[MAX_LOD_LEVELS];
+
+	// Patches picked by the last Select: texel origin, vertex spacing in texels and level
+	vector<glm::vec4> Patches;
+
+	unsigned int PatchVAO, PatchEBO, PatchBufferID, WaterPatchBufferID, SelectedPatchBufferID, DrawCommandBufferID;
+	unsigned int PatchIndexCount;
+
+	// Height bounds pyramid, level L holds the lowest and highest height and the deepest water under every patch of level L
+	unsigned int HeightBoundsTextureID;
+	unsigned int HeightBoundsWidth;
+	unsigned int HeightBoundsHeight;
+	unsigned int HeightBoundsLevels;
+
+	// constructor only records the layout, the buffers are created by Generate
+	// The patch resolution must be even, so a patch vertex grid contains the grid of the next coarser level
+	ChunkedTerrain(unsigned int gridWidth, unsigned int gridHeight, unsigned int patchResolution, float cellSize, float heightBound) {
+		GridWidth = gridWidth;
+		GridHeight = gridHeight;
+		CellSize = cellSize;
+		HeightBound = heightBound;
+		PatchResolution = patchResolution;
+
+		// The root node spans at least the whole grid
+		NumberLevels = 1;
+		while (NodeSize(NumberLevels - 1) < max(gridWidth, gridHeight) - 1 && NumberLevels < MAX_LOD_LEVELS) {
+			NumberLevels++;
+		}
+
+		// The pyramid sides are powers of two, so its blocks halve along with the patches of each level
+		HeightBoundsWidth = 1;
+		while (HeightBoundsWidth * PatchResolution < gridWidth - 1) {
+			HeightBoundsWidth *= 2;
+		}
+		HeightBoundsHeight = 1;
+		while (HeightBoundsHeight * PatchResolution < gridHeight - 1) {
+			HeightBoundsHeight *= 2;
+		}
+		HeightBoundsLevels = 1;
+		while ((1u << (HeightBoundsLevels - 1)) < max(HeightBoundsWidth, HeightBoundsHeight)) {
+			HeightBoundsLevels++;
+		}
+
+		PatchVAO = 0;
+		PatchEBO = 0;
+		PatchBufferID = 0;
+		WaterPatchBufferID = 0;
+		SelectedPatchBufferID = 0;
+		DrawCommandBufferID = 0;
+		PatchIndexCount = 0;
+		HeightBoundsTextureID = 0;
+	}
+
+	// Create the patch indices, a PatchResolution grid of quads whose vertex index i + j * (PatchResolution + 1) is vertex (i, j),
+	// the patch buffers and the height bounds pyramid. The indices let vertices shared by neighboring quads be shaded once
+	void Generate() {
+		vector<unsigned int> indices;
+		indices.reserve(6 * PatchResolution * PatchResolution);
+		unsigned int width = PatchResolution + 1;
+		for (unsigned int j = 0; j < PatchResolution; j++) {
+			for (unsigned int i = 0; i < PatchResolution; i++) {
+				unsigned int index = i + j * width;
+
+				// first triangle
+				indices.push_back(index);
+				indices.push_back(index + width);
+				indices.push_back(index + 1);
+
+				// second triangle
+				indices.push_back(index + width + 1);
+				indices.push_back(index + 1);
+				indices.push_back(index + width);
+			}
+		}
+		PatchIndexCount = indices.size();
+
+		// The vertex array has no attributes, it only holds the indices
+		glGenVertexArrays(1, &PatchVAO);
+		glGenBuffers(1, &PatchEBO);
+		glGenBuffers(1, &PatchBufferID);
+		glGenBuffers(1, &WaterPatchBufferID);
+		glGenBuffers(1, &SelectedPatchBufferID);
+		glGenBuffers(1, &DrawCommandBufferID);
+
+		glBindVertexArray(PatchVAO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, PatchEBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+		glBindVertexArray(0);
+
+		// patch origin, spacing and level, one per instance
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, PatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::vec4), NULL, GL_STREAM_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, PATCHES_BINDING, PatchBufferID);
+
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, WaterPatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::vec4), NULL, GL_STREAM_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, WATER_PATCHES_BINDING, WaterPatchBufferID);
+
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, SelectedPatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(glm::vec4), NULL, GL_STREAM_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SELECTED_PATCHES_BINDING, SelectedPatchBufferID);
+
+		// A DrawElementsIndirectCommand per draw: count, instanceCount, firstIndex, baseVertex, baseInstance
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, DrawCommandBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, NUMBER_DRAWS * 5 * sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_COMMAND_BINDING, DrawCommandBufferID);
+
+		// Every level is allocated, so the texture is complete for the texel fetches of the culling shader
+		glGenTextures(1, &HeightBoundsTextureID);
+		glBindTexture(GL_TEXTURE_2D, HeightBoundsTextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, HeightBoundsLevels - 1);
+		glTexStorage2D(GL_TEXTURE_2D, HeightBoundsLevels, GL_RGBA32F, HeightBoundsWidth, HeightBoundsHeight);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	// Rebuild the height bounds pyramid from the column data and water data textures the render shaders draw
+	void UpdateHeightBounds(Shader &heightBoundsShader, Shader &heightBoundsReductionShader, unsigned int columnDataTextureID, unsigned int waterDataTextureID) {
+		heightBoundsShader.use();
+		// Link HeightBoundsTextureID to the output (binding = 0) of the height bounds shader
+		glBindImageTexture(0, HeightBoundsTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+		// Link columnDataTextureID to binding = 1 in the height bounds shader
+		glBindImageTexture(1, columnDataTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+		// Link waterDataTextureID to binding = 2 in the height bounds shader
+		glBindImageTexture(2, waterDataTextureID, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+
+		glDispatchCompute((HeightBoundsWidth + 7) / 8, (HeightBoundsHeight + 7) / 8, 1);
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		heightBoundsReductionShader.use();
+		for (unsigned int level = 1; level < HeightBoundsLevels; level++) {
+			// Link level of HeightBoundsTextureID to the output (binding = 0) of the height bounds reduction shader
+			glBindImageTexture(0, HeightBoundsTextureID, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+			// Link the next finer level of HeightBoundsTextureID to binding = 1 in the height bounds reduction shader
+			glBindImageTexture(1, HeightBoundsTextureID, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+
+			glDispatchCompute((max(1u, HeightBoundsWidth >> level) + 7) / 8, (max(1u, HeightBoundsHeight >> level) + 7) / 8, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+
+		// Make the pyramid visible to the texel fetches of the culling shader
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+	}
+
+	// Pick the patches for an eye given in the grid's model space and upload them for Cull
+	// A level's geometric error is taken as its vertex spacing, which may show as at most pixelError pixels
+	void Select(const glm::vec3 &eye, float fieldOfView, float viewportHeight, float pixelError) {
+		// Distance at which a world size of one shows as pixelError pixels
+		float errorDistance = viewportHeight / (2.0f * tan(fieldOfView / 2.0f) * pixelError);
+
+		// Level 0 is drawn until level 1's spacing is small enough. It must also span twice a node diagonal,
+		// so that neighboring patches never differ by more than one level
+		float nodeDiagonal = 1.41421356f * NodeSize(0) * CellSize;
+		LevelRanges[0] = max(2.0f * CellSize * errorDistance, 2.0f * nodeDiagonal);
+		MorphStarts[0] = LOD_MORPH_START_RATIO * LevelRanges[0];
+		for (unsigned int level = 1; level < NumberLevels; level++) {
+			LevelRanges[level] = 2.0f * LevelRanges[level - 1];
+			MorphStarts[level] = LevelRanges[level - 1] + LOD_MORPH_START_RATIO * (LevelRanges[level] - LevelRanges[level - 1]);
+		}
+
+		// The root level covers everything and never morphs
+		LevelRanges[NumberLevels - 1] = 2e30f;
+		MorphStarts[NumberLevels - 1] = 1e30f;
+
+		Patches.clear();
+		SelectNode(0, 0, NumberLevels - 1, eye);
+
+		// Orphan the buffers so the upload does not wait on the previous frame's culling and draws, they keep their bindings
+		// Every picked patch may turn out visible, so the visible patches buffers are sized for all of them
+		size_t patchesSize = max((size_t)1, Patches.size()) * sizeof(glm::vec4);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, PatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, patchesSize, NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, WaterPatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, patchesSize, NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, SelectedPatchBufferID);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, patchesSize, NULL, GL_STREAM_DRAW);
+		if (!Patches.empty()) {
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, Patches.size() * sizeof(glm::vec4), &Patches[0]);
+		}
+	}
+
+	// Keep the picked patches whose height bounds box may be seen through the model view projection, for Draw
+	// The height bounds pyramid must be up to date
+	void Cull(Shader &patchCullingShader, const glm::mat4 &modelViewProjection) {
+		// Reset the draw arguments to the whole patch and no instances
+		GLuint emptyDrawCommands[NUMBER_DRAWS][5] = {
+			{ PatchIndexCount, 0, 0, 0, 0 },
+			{ PatchIndexCount, 0, 0, 0, 0 }
+		};
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, DrawCommandBufferID);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(emptyDrawCommands), emptyDrawCommands);
+
+		patchCullingShader.use();
+		patchCullingShader.setInt("selectedPatchCount", Patches.size());
+		patchCullingShader.setMat4("modelViewProjection", modelViewProjection);
+		patchCullingShader.setInt("heightBoundsTexture", 0);
+
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, HeightBoundsTextureID);
+
+		glDispatchCompute((Patches.size() + PATCH_CULLING_GROUP_SIZE - 1) / PATCH_CULLING_GROUP_SIZE, 1, 1);
+		// Make the visible patches and their count visible to the render shaders and the indirect draws
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+	}
+
+	// Give a render shader the morph range of every level, as set by the last Select
+	void SetMorphRanges(const Shader &shader) const {
+		for (unsigned int level = 0; level < NumberLevels; level++) {
+			shader.setVec2("morphRanges[" + to_string(level) + "]", MorphStarts[level], LevelRanges[level]);
+		}
+	}
+
+	// Draw the visible patches left by the last Cull for TERRAIN_DRAW or WATER_DRAW
+	void Draw(unsigned int draw) const {
+		glBindVertexArray(PatchVAO);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, DrawCommandBufferID);
+		glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(draw * 5 * sizeof(GLuint)));
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		glBindVertexArray(0);
+	}
+
+	void Delete() {
+		glDeleteVertexArrays(1, &PatchVAO);
+		glDeleteBuffers(1, &PatchEBO);
+		glDeleteBuffers(1, &PatchBufferID);
+		glDeleteBuffers(1, &WaterPatchBufferID);
+		glDeleteBuffers(1, &SelectedPatchBufferID);
+		glDeleteBuffers(1, &DrawCommandBufferID);
+		glDeleteTextures(1, &HeightBoundsTextureID);
+	}
+
+private:
+	// Cells along the edge of a node
+	unsigned int NodeSize(unsigned int level) const {
+		return (2 * PatchResolution) << level;
+	}
+
+	// Whether any point of a node lies within range of the eye
+	bool IsInRange(unsigned int x, unsigned int z, unsigned int level, const glm::vec3 &eye, float range) const {
+		glm::vec3 boxMin(x * CellSize, -HeightBound, z * CellSize);
+		glm::vec3 boxMax(min(x + NodeSize(level), GridWidth - 1) * CellSize, HeightBound, min(z + NodeSize(level), GridHeight - 1) * CellSize);
+		glm::vec3 nearest = glm::clamp(eye, boxMin, boxMax);
+
+		return glm::dot(nearest - eye, nearest - eye) <= range * range;
+	}
+
+	void AddPatch(unsigned int x, unsigned int z, unsigned int level) {
+		if (x < GridWidth - 1 && z < GridHeight - 1) {
+			Patches.push_back(glm::vec4((float)x, (float)z, (float)(1 << level), (float)level));
+		}
+	}
+
+	// Returns false when the node is out of its level's range, its parent then draws the area
+	bool SelectNode(unsigned int x, unsigned int z, unsigned int level, const glm::vec3 &eye) {
+		// Nodes past the grid edge have nothing to draw
+		if (x >= GridWidth - 1 || z >= GridHeight - 1) {
+			return true;
+		}
+
+		if (!IsInRange(x, z, level, eye, LevelRanges[level])) {
+			return false;
+		}
+
+		unsigned int half = NodeSize(level) / 2;
+
+		// The whole node is drawn at this level when none of it is close enough for the next finer one
+		if (level == 0 || !IsInRange(x, z, level, eye, LevelRanges[level - 1])) {
+			AddPatch(x, z, level);
+			AddPatch(x + half, z, level);
+			AddPatch(x, z + half, level);
+			AddPatch(x + half, z + half, level);
+			return true;
+		}
+
+		// Children out of the finer level's range are drawn at this level
+		for (unsigned int child = 0; child < 4; child++) {
+			unsigned int childX = x + (child % 2) * half;
+			unsigned int childZ = z + (child / 2) * half;
+			if (!SelectNode(childX, childZ, level - 1, eye)) {
+				AddPatch(childX, childZ, level);
+			}
+		}
+
+		return true;
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,199 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Offscreen framebuffer whose frames are recorded to a video encoder or an image sequence
+// A captured frame is read back into one of a ring of pixel buffers, and only written out once its buffer comes around
+// again, so the read back overlaps the next frames instead of stalling the frame that issued it
+class FrameRecorder {
+public:
+	unsigned int Width;
+	unsigned int Height;
+
+	unsigned int FramebufferID, ColorRenderbufferID, DepthRenderbufferID;
+
+	// Frames read back and frames written out
+	unsigned int CapturedFrames;
+	unsigned int WrittenFrames;
+
+	// constructor only records the layout, the framebuffer and pixel buffers are created by Generate
+	FrameRecorder(unsigned int width, unsigned int height, unsigned int numberPixelBuffers) {
+		Width = width;
+		Height = height;
+		FramebufferID = 0;
+		ColorRenderbufferID = 0;
+		DepthRenderbufferID = 0;
+		CapturedFrames = 0;
+		WrittenFrames = 0;
+		pixelBufferIDs.resize(numberPixelBuffers, 0);
+		fences.resize(numberPixelBuffers, 0);
+		encoder = NULL;
+	}
+
+	// Frames are piped as raw top-down RGB to the standard input of the encoder command, or written as binary PPM files
+	// named by the printf pattern of the frame number when the command is empty
+	bool Open(const string &encoderCommand, const string &framePattern) {
+		this->framePattern = framePattern;
+
+		if (!encoderCommand.empty()) {
+#ifdef _WIN32
+			encoder = _popen(encoderCommand.c_str(), "wb");
+#else
+			encoder = popen(encoderCommand.c_str(), "w");
+#endif
+			if (encoder == NULL) {
+				cout << "ERROR::FRAME_RECORDER::ENCODER_NOT_STARTED " << encoderCommand << endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void Generate() {
+		glGenFramebuffers(1, &FramebufferID);
+		glGenRenderbuffers(1, &ColorRenderbufferID);
+		glGenRenderbuffers(1, &DepthRenderbufferID);
+
+		glBindRenderbuffer(GL_RENDERBUFFER, ColorRenderbufferID);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, Width, Height);
+		glBindRenderbuffer(GL_RENDERBUFFER, DepthRenderbufferID);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, Width, Height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, FramebufferID);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, ColorRenderbufferID);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, DepthRenderbufferID);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+			cout << "ERROR::FRAME_RECORDER::FRAMEBUFFER_NOT_COMPLETE" << endl;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// Tightly packed RGB rows, as they are written out
+		glGenBuffers(pixelBufferIDs.size(), &pixelBufferIDs[0]);
+		for (size_t i = 0; i < pixelBufferIDs.size(); i++) {
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBufferIDs[i]);
+			glBufferData(GL_PIXEL_PACK_BUFFER, FrameSize(), NULL, GL_STREAM_READ);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	// Draw the following passes to the recorder's framebuffer
+	void Bind() {
+		glBindFramebuffer(GL_FRAMEBUFFER, FramebufferID);
+		glViewport(0, 0, Width, Height);
+	}
+
+	// Start the read back of the framebuffer, writing out the oldest frame first when every pixel buffer is in use
+	void CaptureFrame() {
+		unsigned int buffer = CapturedFrames % pixelBufferIDs.size();
+		if (CapturedFrames - WrittenFrames == pixelBufferIDs.size()) {
+			WriteOldestFrame();
+		}
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, FramebufferID);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBufferIDs[buffer]);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, Width, Height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		fences[buffer] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		CapturedFrames++;
+	}
+
+	// Write out every frame still in flight and close the encoder, which then finishes the video
+	void Finish() {
+		while (WrittenFrames < CapturedFrames) {
+			WriteOldestFrame();
+		}
+
+		if (encoder != NULL) {
+#ifdef _WIN32
+			_pclose(encoder);
+#else
+			pclose(encoder);
+#endif
+			encoder = NULL;
+		}
+	}
+
+	void Delete() {
+		for (size_t i = 0; i < fences.size(); i++) {
+			if (fences[i] != 0) {
+				glDeleteSync(fences[i]);
+				fences[i] = 0;
+			}
+		}
+		glDeleteBuffers(pixelBufferIDs.size(), &pixelBufferIDs[0]);
+		glDeleteFramebuffers(1, &FramebufferID);
+		glDeleteRenderbuffers(1, &ColorRenderbufferID);
+		glDeleteRenderbuffers(1, &DepthRenderbufferID);
+	}
+
+private:
+	vector<unsigned int> pixelBufferIDs;
+	vector<GLsync> fences;
+	string framePattern;
+	FILE *encoder;
+
+	size_t FrameSize() const {
+		return (size_t)Width * Height * 3;
+	}
+
+	void WriteOldestFrame() {
+		unsigned int buffer = WrittenFrames % pixelBufferIDs.size();
+
+		// Wait for the read back to land in the pixel buffer
+		while (glClientWaitSync(fences[buffer], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fences[buffer]);
+		fences[buffer] = 0;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBufferIDs[buffer]);
+		const unsigned char *pixels = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, FrameSize(), GL_MAP_READ_BIT);
+		if (pixels != NULL) {
+			WriteFrame(pixels, WrittenFrames);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		else {
+			cout << "ERROR::FRAME_RECORDER::PIXEL_BUFFER_NOT_MAPPED" << endl;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		WrittenFrames++;
+	}
+
+	// OpenGL rows run bottom up, the video and image rows top down
+	void WriteFrame(const unsigned char *pixels, unsigned int frame) {
+		FILE *file = encoder;
+
+		if (file == NULL) {
+			vector<char> fileName(framePattern.size() + 32);
+			snprintf(&fileName[0], fileName.size(), framePattern.c_str(), frame);
+			file = fopen(&fileName[0], "wb");
+			if (file == NULL) {
+				cout << "ERROR::FRAME_RECORDER::FRAME_FILE_NOT_OPENED " << &fileName[0] << endl;
+				return;
+			}
+			fprintf(file, "P6\n%u %u\n255\n", Width, Height);
+		}
+
+		size_t rowSize = (size_t)Width * 3;
+		for (unsigned int row = Height; row-- > 0;) {
+			fwrite(pixels + row * rowSize, 1, rowSize, file);
+		}
+
+		if (file != encoder) {
+			fclose(file);
+		}
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,299 @@
+#version 460 core
+out vec4 FragColor;
+
+in vec2 ScreenPosition;
+
+struct DirLight{
+	vec3 direction;
+
+	// phong lighting variables
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+
+uniform mat4 model;
+uniform mat4 modelViewProjection;
+uniform mat4 inverseModelViewProjection;
+uniform mat3 normalMatrix;
+
+// Render data of the terrain and water surface texels, see renderPrep.ComputeShader
+uniform usampler2DArray renderDataTexture;
+// Terrain detail noise in r and grass detail noise in g, see detailNoise.ComputeShader
+uniform sampler2D detailNoiseTexture;
+// Highest water surface over every block of 2^L x 2^L cells in level L, see HeightfieldRayMarcher
+uniform sampler2D maxHeightTexture;
+uniform int maxHeightLevels;
+
+uniform vec2 gridSize; // Position of the last texel
+uniform float cellSize;
+
+uniform vec3 viewPos;
+uniform DirLight dirLight;
+
+uniform vec3 terrainColor;
+uniform vec3 vegetationColor;
+uniform vec3 deadVegetationColor;
+uniform vec3 waterColor;
+uniform vec3 terrainSpecularColor;
+uniform vec3 waterSpecularColor;
+uniform float terrainShininess;
+uniform float waterShininess;
+
+const int TERRAIN_LAYER = 0;
+const int WATER_LAYER = 1;
+
+// Steps a ray may take through the pyramid. Only rays grazing a surface use them all, so such a ray is taken to hit it
+// where it has got to instead of leaving a hole
+const int MAX_RAY_STEPS = 1024;
+// Distance in cells a ray is moved on past a block edge along its longer horizontal axis, so it lands in the next block
+const float CELL_EPSILON = 0.01f;
+
+// The rays are marched in grid space, model space scaled so a cell is one unit wide
+// A surface point there lies at (i, height / cellSize, j) for texel (i, j)
+
+float Height(uvec4 renderData){
+	return uintBitsToFloat(renderData.x);
+}
+
+vec3 SurfaceNormal(uvec4 renderData){
+	vec2 normal = unpackSnorm2x16(renderData.y);
+	return vec3(normal.x, sqrt(max(0.0f, 1.0f - dot(normal, normal))), normal.y);
+}
+
+uvec4 RenderData(ivec2 texel, int layer){
+	return texelFetch(renderDataTexture, ivec3(min(texel, ivec2(gridSize)), layer), 0);
+}
+
+// Surface of a layer at a grid position, bilinear between the four texels around it as the triangles of the grid are
+struct Surface{
+	float height;
+	vec3 normal;
+	vec2 colorFactors;
+};
+
+Surface SampleSurface(vec2 gridPosition, int layer){
+	ivec2 cell = ivec2(min(floor(gridPosition), gridSize - 1.0f));
+	vec2 weights = clamp(gridPosition - vec2(cell), 0.0f, 1.0f);
+
+	Surface surface = Surface(0.0f, vec3(0.0f), vec2(0.0f));
+	for(int j = 0; j < 2; j++){
+		for(int i = 0; i < 2; i++){
+			uvec4 renderData = RenderData(cell + ivec2(i, j), layer);
+			float weight = mix(1.0f - weights.x, weights.x, float(i)) * mix(1.0f - weights.y, weights.y, float(j));
+
+			surface.height += weight * Height(renderData);
+			surface.normal += weight * SurfaceNormal(renderData);
+			surface.colorFactors += weight * unpackHalf2x16(renderData.z);
+		}
+	}
+	surface.normal = normalize(surface.normal);
+
+	return surface;
+}
+
+// First point of a cell's bilinear surface along the ray between distances tStart and tEnd
+// Along the ray the gap between the ray and the surface is a quadratic in the distance, whose first root is the hit
+bool IntersectCell(vec3 origin, vec3 direction, ivec2 cell, float tStart, float tEnd, int layer, out float tHit){
+	float h00 = Height(RenderData(cell, layer)) / cellSize;
+	float h10 = Height(RenderData(cell + ivec2(1, 0), layer)) / cellSize;
+	float h01 = Height(RenderData(cell + ivec2(0, 1), layer)) / cellSize;
+	float h11 = Height(RenderData(cell + ivec2(1, 1), layer)) / cellSize;
+
+	// h(x, z) = h00 + b x + c z + e x z over the cell
+	float b = h10 - h00;
+	float c = h01 - h00;
+	float e = h00 - h10 - h01 + h11;
+
+	vec3 start = origin + direction * tStart - vec3(cell.x, 0.0f, cell.y);
+	float qa = -e * direction.x * direction.z;
+	float qb = direction.y - (b * direction.x + c * direction.z + e * (start.x * direction.z + start.z * direction.x));
+	float qc = start.y - (h00 + b * start.x + c * start.z + e * start.x * start.z);
+
+	// A ray that enters the cell under the surface sees the heightfield from below or from its side, where it has no faces
+	// Otherwise the first root is where the ray goes down through the surface
+	if(qc <= 0.0f){
+		return false;
+	}
+
+	float segmentLength = tEnd - tStart;
+	float s = -1.0f;
+	if(abs(qa) < 1e-6f){
+		if(qb < 0.0f){
+			s = -qc / qb;
+		}
+	}
+	else{
+		float discriminant = qb * qb - 4.0f * qa * qc;
+		if(discriminant >= 0.0f){
+			// Both roots without cancellation
+			float q = -0.5f * (qb + (qb < 0.0f ? -1.0f : 1.0f) * sqrt(discriminant));
+			float root0 = q / qa;
+			float root1 = q != 0.0f ? qc / q : -1.0f;
+			float firstRoot = min(root0, root1);
+			s = firstRoot >= 0.0f ? firstRoot : max(root0, root1);
+		}
+	}
+
+	if(s < 0.0f || s > segmentLength){
+		return false;
+	}
+
+	tHit = tStart + s;
+	return true;
+}
+
+// First hit of a layer's surface along the ray between distances tStart and tEnd
+// The ray descends the pyramid wherever it may touch a block's surface, steps over the blocks it passes above,
+// and climbs one level after leaving a block, so open stretches are crossed with coarse blocks again
+bool Trace(vec3 origin, vec3 direction, float tStart, float tEnd, int layer, out float tHit){
+	int topLevel = maxHeightLevels - 1;
+	int level = topLevel;
+	float t = tStart;
+	// Distance to the next block edge per grid unit along x and z, rays parallel to an axis never reach its edges
+	vec2 inverseDirection = vec2(direction.x != 0.0f ? 1.0f / direction.x : 1e30f, direction.z != 0.0f ? 1.0f / direction.z : 1e30f);
+	// The block is looked up a little further along the ray, which crosses a corner into the diagonal block like the ray does
+	float tEpsilon = CELL_EPSILON / max(max(abs(direction.x), abs(direction.z)), 1e-6f);
+
+	for(int rayStep = 0; t < tEnd; rayStep++){
+		if(rayStep == MAX_RAY_STEPS){
+			tHit = t;
+			return true;
+		}
+
+		float blockSize = float(1 << level);
+		vec2 position = origin.xz + direction.xz * (t + tEpsilon);
+		if(any(lessThan(position, vec2(0.0f))) || any(greaterThan(position, gridSize))){
+			break;
+		}
+		ivec2 block = ivec2(floor(position / blockSize));
+
+		vec2 blockExit = (vec2(block) + step(0.0f, direction.xz)) * blockSize;
+		vec2 tBlockExits = (blockExit - origin.xz) * inverseDirection;
+		float tBlockExit = min(min(tBlockExits.x, tBlockExits.y), tEnd);
+
+		float maxHeight = texelFetch(maxHeightTexture, block, level).r / cellSize;
+		float rayLowest = min(origin.y + direction.y * t, origin.y + direction.y * tBlockExit);
+
+		if(rayLowest > maxHeight){
+			t = tBlockExit;
+			level = min(level + 1, topLevel);
+			continue;
+		}
+
+		if(level > 0){
+			level--;
+			continue;
+		}
+
+		if(IntersectCell(origin, direction, block, t, tBlockExit, layer, tHit)){
+			return true;
+		}
+
+		t = tBlockExit;
+		level = min(level + 1, topLevel);
+	}
+
+	return false;
+}
+
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir, vec3 color, vec3 specularColor, float shininess, out float spec){
+	vec3 lightDir = normalize(-light.direction);
+
+	// Diffuse Shading
+	float diff = max(dot(normal, lightDir), 0.0f);
+
+	// Specular Shading
+	vec3 reflectDir = reflect(-lightDir, normal);
+	spec = pow(max(dot(viewDir, reflectDir), 0.0f), shininess);
+
+	// Combine Results
+	vec3 ambient = light.ambient * color;
+	vec3 diffuse = light.diffuse * diff * color;
+	vec3 specular = light.specular * spec * specularColor;
+
+	return (ambient + diffuse + specular);
+}
+
+// Terrain colored by its vegetation and dead vegetation, as terrainRender.vs and terrainRender.fs shade it
+vec3 ShadeTerrain(vec3 gridPoint){
+	Surface surface = SampleSurface(gridPoint.xz, TERRAIN_LAYER);
+	vec3 color = mix(mix(terrainColor, vegetationColor, surface.colorFactors.x), deadVegetationColor, surface.colorFactors.y);
+	vec3 fragPos = vec3(model * vec4(gridPoint * cellSize, 1.0f));
+
+	vec3 result = vec3(0, 0, 0);
+
+	vec2 detailNoise = texture(detailNoiseTexture, gridPoint.xz / gridSize).rg;
+	if(color.r > color.g){
+		result += detailNoise.r;
+	}
+	else{
+		result += detailNoise.g;
+	}
+
+	float spec;
+	result += CalcDirLight(dirLight, normalize(normalMatrix * surface.normal), normalize(viewPos - fragPos), color, terrainSpecularColor, terrainShininess, spec);
+
+	return result;
+}
+
+// Water colored and made opaque by the sediment it carries, as waterRender.vs and waterRender.fs shade it
+vec4 ShadeWater(vec3 gridPoint, Surface surface){
+	vec3 color = mix(waterColor, terrainColor, surface.colorFactors.x);
+	vec3 fragPos = vec3(model * vec4(gridPoint * cellSize, 1.0f));
+
+	float spec;
+	vec3 result = CalcDirLight(dirLight, normalize(normalMatrix * surface.normal), normalize(viewPos - fragPos), color, waterSpecularColor, waterShininess, spec);
+
+	return vec4(result, max(mix(0.3f, 1.0f, surface.colorFactors.y), spec));
+}
+
+void main()
+{
+	// Ray through the pixel from the near plane to the far plane
+	vec4 nearPoint = inverseModelViewProjection * vec4(ScreenPosition, -1.0f, 1.0f);
+	vec4 farPoint = inverseModelViewProjection * vec4(ScreenPosition, 1.0f, 1.0f);
+	vec3 origin = nearPoint.xyz / nearPoint.w / cellSize;
+	vec3 rayEnd = farPoint.xyz / farPoint.w / cellSize;
+	vec3 direction = normalize(rayEnd - origin);
+
+	// Clip the ray to the box of the grid under its highest surface
+	float topHeight = texelFetch(maxHeightTexture, ivec2(0), maxHeightLevels - 1).r / cellSize;
+	vec3 boxMin = vec3(0.0f, -1e30f, 0.0f);
+	vec3 boxMax = vec3(gridSize.x, topHeight, gridSize.y);
+	vec3 inverseDirection = vec3(direction.x != 0.0f ? 1.0f / direction.x : 1e30f, direction.y != 0.0f ? 1.0f / direction.y : 1e30f, direction.z != 0.0f ? 1.0f / direction.z : 1e30f);
+	vec3 tBoxMin = (boxMin - origin) * inverseDirection;
+	vec3 tBoxMax = (boxMax - origin) * inverseDirection;
+	vec3 tNear = min(tBoxMin, tBoxMax);
+	vec3 tFar = max(tBoxMin, tBoxMax);
+	float tEnter = max(max(tNear.x, tNear.y), max(tNear.z, 0.0f));
+	float tExit = min(min(tFar.x, tFar.y), min(tFar.z, distance(origin, rayEnd)));
+
+	// The water surface lies on or above the terrain, so the ray meets it first
+	float tSurface;
+	if(tEnter >= tExit || !Trace(origin, direction, tEnter, tExit, WATER_LAYER, tSurface)){
+		discard;
+	}
+
+	vec3 surfacePoint = origin + direction * tSurface;
+	Surface water = SampleSurface(surfacePoint.xz, WATER_LAYER);
+	float waterDepth = water.height - SampleSurface(surfacePoint.xz, TERRAIN_LAYER).height;
+
+	vec3 result;
+	if(waterDepth <= 0.0f){
+		result = ShadeTerrain(surfacePoint);
+	}
+	else{
+		// The terrain seen through the water, blended under it as the water draw blends over the terrain draw
+		vec4 waterResult = ShadeWater(surfacePoint, water);
+		float tTerrain;
+		vec3 terrainResult = Trace(origin, direction, tSurface, tExit, TERRAIN_LAYER, tTerrain) ? ShadeTerrain(origin + direction * tTerrain) : vec3(0.0f);
+		result = mix(terrainResult, waterResult.rgb, waterResult.a);
+	}
+
+	// Depth of the first surface, so anything drawn after the pass is hidden behind the heightfield as with the patches
+	vec4 clipPosition = modelViewProjection * vec4(surfacePoint * cellSize, 1.0f);
+	gl_FragDepth = 0.5f * clipPosition.z / clipPosition.w + 0.5f;
+
+	FragColor = vec4(result, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#version 460 core
+// A triangle covering the screen, drawn without vertex attributes
+out vec2 ScreenPosition;
+
+void main()
+{
+	ScreenPosition = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0f - 1.0f;
+	gl_Position = vec4(ScreenPosition, 0.0f, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef HEIGHTFIELD_RAY_MARCHER_H
+#define HEIGHTFIELD_RAY_MARCHER_H
+
+#include <glad/glad.h>
+
+#include "shader.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// Ray marching of the terrain and water heightfields in a full screen pass, an alternative to drawing the grid as triangles
+// Every ray walks down a pyramid of the highest water surface over every block of cells, stepping over a whole block whenever
+// it passes above the block's highest height, and only intersects the bilinear surface of the cells it reaches at level 0.
+// A pixel costs a few steps per pyramid level, so the cost grows with the screen and only the log of the grid size
+// The water surface lies on or above the terrain, so the same pyramid bounds both surfaces
+class HeightfieldRayMarcher {
+public:
+	// grid attributes, a surface vertex for every texel
+	unsigned int GridWidth;
+	unsigned int GridHeight;
+
+	// Max height pyramid, level L holds the highest water surface over every block of 2^L x 2^L cells
+	unsigned int MaxHeightTextureID;
+	unsigned int MaxHeightWidth;
+	unsigned int MaxHeightHeight;
+	unsigned int MaxHeightLevels;
+
+	// The full screen triangle has no vertex attributes, its vertex array is empty
+	unsigned int ScreenVAO;
+
+	// constructor only records the layout, the pyramid is created by Generate
+	HeightfieldRayMarcher(unsigned int gridWidth, unsigned int gridHeight) {
+		GridWidth = gridWidth;
+		GridHeight = gridHeight;
+
+		// The pyramid sides are powers of two, so every block of a level is split into 2x2 blocks of the next finer one
+		MaxHeightWidth = 1;
+		while (MaxHeightWidth < gridWidth - 1) {
+			MaxHeightWidth *= 2;
+		}
+		MaxHeightHeight = 1;
+		while (MaxHeightHeight < gridHeight - 1) {
+			MaxHeightHeight *= 2;
+		}
+		MaxHeightLevels = 1;
+		while ((1u << (MaxHeightLevels - 1)) < max(MaxHeightWidth, MaxHeightHeight)) {
+			MaxHeightLevels++;
+		}
+
+		MaxHeightTextureID = 0;
+		ScreenVAO = 0;
+	}
+
+	void Generate() {
+		glGenVertexArrays(1, &ScreenVAO);
+
+		// Every level is allocated, so the texture is complete for the texel fetches of the ray march shader
+		glGenTextures(1, &MaxHeightTextureID);
+		glBindTexture(GL_TEXTURE_2D, MaxHeightTextureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MaxHeightLevels - 1);
+		glTexStorage2D(GL_TEXTURE_2D, MaxHeightLevels, GL_R32F, MaxHeightWidth, MaxHeightHeight);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	// Rebuild the max height pyramid from the render data texture the ray march shader draws
+	void UpdateMaxHeights(Shader &maxHeightShader, Shader &maxHeightReductionShader, unsigned int renderDataTextureID) {
+		maxHeightShader.use();
+		// Link MaxHeightTextureID to the output (binding = 0) of the max height shader
+		glBindImageTexture(0, MaxHeightTextureID, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+		// Link renderDataTextureID to binding = 1 in the max height shader
+		glBindImageTexture(1, renderDataTextureID, 0, GL_TRUE, 0, GL_READ_ONLY, GL_RGBA32UI);
+
+		glDispatchCompute((MaxHeightWidth + 7) / 8, (MaxHeightHeight + 7) / 8, 1);
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		maxHeightReductionShader.use();
+		for (unsigned int level = 1; level < MaxHeightLevels; level++) {
+			// Link level of MaxHeightTextureID to the output (binding = 0) of the max height reduction shader
+			glBindImageTexture(0, MaxHeightTextureID, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+			// Link the next finer level of MaxHeightTextureID to binding = 1 in the max height reduction shader
+			glBindImageTexture(1, MaxHeightTextureID, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+
+			glDispatchCompute((max(1u, MaxHeightWidth >> level) + 7) / 8, (max(1u, MaxHeightHeight >> level) + 7) / 8, 1);
+			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+		}
+
+		// Make the pyramid visible to the texel fetches of the ray march shader
+		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+	}
+
+	// Draw a triangle over the whole screen with the ray march shader, whose textures and uniforms are set by the caller
+	void Draw() {
+		glBindVertexArray(ScreenVAO);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glBindVertexArray(0);
+	}
+
+	void Delete() {
+		glDeleteVertexArrays(1, &ScreenVAO);
+		glDeleteTextures(1, &MaxHeightTextureID);
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+#ifndef INITIAL_STATE_CACHE_H
+#define INITIAL_STATE_CACHE_H
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// FNV-1a hash of the parameters a scenario is generated from, which are added one by one
+class InitialStateKey {
+public:
+	uint64_t Value;
+
+	InitialStateKey() {
+		Value = 14695981039346656037ull;
+	}
+
+	template <class T>
+	void Add(const T &parameter) {
+		const unsigned char *bytes = (const unsigned char*)&parameter;
+		for (size_t i = 0; i < sizeof(T); i++) {
+			Value ^= bytes[i];
+			Value *= 1099511628211ull;
+		}
+	}
+};
+
+// Generated initial column data textures kept in files under a cache directory, named by the key of the scenario parameters
+// A run with the parameters of an earlier one maps its file and uploads the texture straight from the mapping instead of
+// generating it again. A file holds a small header and the RGBA float texels row by row
+class InitialStateCache {
+public:
+	// constructor only records the directory, which must exist
+	InitialStateCache(const string &directory) {
+		this->directory = directory;
+	}
+
+	// Upload the cached state of the key into the RGBA32F texture, false when there is none of this size
+	bool Load(const InitialStateKey &key, unsigned int textureID, unsigned int width, unsigned int height) {
+		string path = Path(key);
+		size_t fileSize = sizeof(Header) + (size_t)width * height * 4 * sizeof(float);
+
+		const char *data = NULL;
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER size;
+		HANDLE mapping = NULL;
+		if (GetFileSizeEx(file, &size) && (unsigned long long)size.QuadPart == fileSize) {
+			mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping != NULL) {
+				data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, fileSize);
+			}
+		}
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+		struct stat status;
+		if (fstat(file, &status) == 0 && (size_t)status.st_size == fileSize) {
+			void *mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapping != MAP_FAILED) {
+				data = (const char*)mapping;
+			}
+		}
+#endif
+
+		bool isLoaded = false;
+		if (data != NULL) {
+			Header header;
+			memcpy(&header, data, sizeof(Header));
+			if (memcmp(header.magic, MAGIC, sizeof(header.magic)) == 0 && header.width == width && header.height == height) {
+				glBindTexture(GL_TEXTURE_2D, textureID);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, data + sizeof(Header));
+				isLoaded = true;
+			}
+		}
+
+		if (!isLoaded) {
+			cout << "ERROR::INITIAL_STATE_CACHE::FILE_NOT_VALID " << path << endl;
+		}
+
+#ifdef _WIN32
+		if (data != NULL) {
+			UnmapViewOfFile(data);
+		}
+		if (mapping != NULL) {
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+#else
+		if (data != NULL) {
+			munmap((void*)data, fileSize);
+		}
+		close(file);
+#endif
+
+		return isLoaded;
+	}
+
+	// Read the RGBA32F texture back and cache it under the key. The file is written under a name of this process and only
+	// then renamed, so runs sharing the directory never map a partly written state
+	void Store(const InitialStateKey &key, unsigned int textureID, unsigned int width, unsigned int height) {
+		vector<float> texels((size_t)width * height * 4);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, &texels[0]);
+
+		Header header;
+		memcpy(header.magic, MAGIC, sizeof(header.magic));
+		header.width = width;
+		header.height = height;
+		header.reserved = 0;
+
+		string path = Path(key);
+#ifdef _WIN32
+		string temporaryPath = path + "." + to_string(GetCurrentProcessId());
+#else
+		string temporaryPath = path + "." + to_string(getpid());
+#endif
+
+		FILE *file = fopen(temporaryPath.c_str(), "wb");
+		if (file == NULL) {
+			cout << "ERROR::INITIAL_STATE_CACHE::FILE_NOT_OPENED " << temporaryPath << endl;
+			return;
+		}
+		bool isWritten = fwrite(&header, sizeof(Header), 1, file) == 1 && fwrite(&texels[0], sizeof(float), texels.size(), file) == texels.size();
+		isWritten = fclose(file) == 0 && isWritten;
+
+#ifdef _WIN32
+		isWritten = isWritten && MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+		isWritten = isWritten && rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+		if (!isWritten) {
+			cout << "ERROR::INITIAL_STATE_CACHE::FILE_NOT_WRITTEN " << path << endl;
+			remove(temporaryPath.c_str());
+		}
+	}
+
+	string Path(const InitialStateKey &key) const {
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.state", (unsigned long long)key.Value);
+		return directory + "/" + name;
+	}
+
+private:
+	struct Header {
+		char magic[4];
+		uint32_t width;
+		uint32_t height;
+		uint32_t reserved;
+	};
+
+	static constexpr const char *MAGIC = "ISC1";
+
+	string directory;
+};
+#endif
\ No newline at end of file
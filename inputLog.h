@@ -0,0 +1,121 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+enum InputEventType { INPUT_MOUSE_MOVE, INPUT_SCROLL };
+
+// A mouse position or a vertical scroll offset in Y, as the GLFW callbacks receive them
+struct InputEvent {
+	InputEventType Type;
+	float X;
+	float Y;
+};
+
+// Input of a frame, its time, the simulation step and time step it starts at, the state of the polled keys one bit each and the
+// mouse and scroll events received since the previous frame
+struct InputFrame {
+	float Time;
+	uint32_t SimulationStep;
+	float TimeStep;
+	uint16_t Keys;
+	vector<InputEvent> Events;
+};
+
+// Binary log of the input frames of a session, written while recording and read back frame by frame while replaying
+// After a small header naming the grid size, every frame takes 16 bytes plus 9 bytes for each of its events
+class InputLog {
+public:
+	bool IsRecording;
+	bool IsReplaying;
+
+	InputLog() {
+		IsRecording = false;
+		IsReplaying = false;
+		file = NULL;
+	}
+
+	// Open the log at path for recording or replaying a session on a width x height grid, a replayed log must have been
+	// recorded on one of the same size
+	bool Open(const char *path, bool isRecording, unsigned int width, unsigned int height) {
+		file = fopen(path, isRecording ? "wb" : "rb");
+		if (file == NULL) {
+			cout << "ERROR::INPUT_LOG::FILE_NOT_OPENED " << path << endl;
+			return false;
+		}
+
+		uint32_t header[3] = { MAGIC, width, height };
+		if (isRecording) {
+			fwrite(header, sizeof(header), 1, file);
+		}
+		else {
+			uint32_t fileHeader[3];
+			if (fread(fileHeader, sizeof(fileHeader), 1, file) != 1 || memcmp(fileHeader, header, sizeof(header)) != 0) {
+				cout << "ERROR::INPUT_LOG::FILE_NOT_VALID " << path << endl;
+				Close();
+				return false;
+			}
+		}
+
+		IsRecording = isRecording;
+		IsReplaying = !isRecording;
+		return true;
+	}
+
+	void Write(const InputFrame &frame) {
+		uint16_t eventCount = (uint16_t)frame.Events.size();
+		fwrite(&frame.Time, sizeof(float), 1, file);
+		fwrite(&frame.SimulationStep, sizeof(uint32_t), 1, file);
+		fwrite(&frame.TimeStep, sizeof(float), 1, file);
+		fwrite(&frame.Keys, sizeof(uint16_t), 1, file);
+		fwrite(&eventCount, sizeof(uint16_t), 1, file);
+		for (uint16_t i = 0; i < eventCount; i++) {
+			uint8_t type = (uint8_t)frame.Events[i].Type;
+			fwrite(&type, sizeof(uint8_t), 1, file);
+			fwrite(&frame.Events[i].X, sizeof(float), 1, file);
+			fwrite(&frame.Events[i].Y, sizeof(float), 1, file);
+		}
+	}
+
+	// Read the next frame, false once the log has ended
+	bool Read(InputFrame &frame) {
+		uint16_t eventCount;
+		if (fread(&frame.Time, sizeof(float), 1, file) != 1 || fread(&frame.SimulationStep, sizeof(uint32_t), 1, file) != 1 ||
+			fread(&frame.TimeStep, sizeof(float), 1, file) != 1 || fread(&frame.Keys, sizeof(uint16_t), 1, file) != 1 ||
+			fread(&eventCount, sizeof(uint16_t), 1, file) != 1) {
+			return false;
+		}
+
+		frame.Events.resize(eventCount);
+		for (uint16_t i = 0; i < eventCount; i++) {
+			uint8_t type;
+			if (fread(&type, sizeof(uint8_t), 1, file) != 1 || fread(&frame.Events[i].X, sizeof(float), 1, file) != 1 ||
+				fread(&frame.Events[i].Y, sizeof(float), 1, file) != 1) {
+				return false;
+			}
+			frame.Events[i].Type = (InputEventType)type;
+		}
+		return true;
+	}
+
+	void Close() {
+		if (file != NULL && fclose(file) != 0 && IsRecording) {
+			cout << "ERROR::INPUT_LOG::FILE_NOT_WRITTEN" << endl;
+		}
+		file = NULL;
+		IsRecording = false;
+		IsReplaying = false;
+	}
+
+private:
+	static const uint32_t MAGIC = 0x32474c49; // "ILG2"
+
+	FILE *file;
+};
+#endif
\ No newline at end of file
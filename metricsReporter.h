@@ -0,0 +1,197 @@
+#ifndef METRICS_REPORTER_H
+#define METRICS_REPORTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+enum MetricsFormat { METRICS_CSV, METRICS_JSON };
+
+// What a frame of the render loop did and how long its parts took on the host, in seconds
+struct FrameMetrics {
+	uint32_t SimulationStep; // After the frame's steps
+	uint32_t Steps;
+	uint32_t MaxReductions; // Max velocity/depth reductions read back for the adaptive time step
+	float DeltaTime;
+	float TimeStep;
+	float SimulationTime;
+	float RenderTime;
+	float RenderScale;
+};
+
+// Fixed size ring of frame metrics between one producer and one consumer thread, neither ever waits for the other
+// The producer drops a frame when the ring is full instead of blocking the render loop, and counts it
+template <unsigned int CAPACITY>
+class MetricsRing {
+public:
+	MetricsRing() : head(0), tail(0), dropped(0) {}
+
+	// Producer only
+	void Push(const FrameMetrics &metrics) {
+		uint32_t currentHead = head.load(memory_order_relaxed);
+		if (currentHead - tail.load(memory_order_acquire) == CAPACITY) {
+			dropped.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+		frames[currentHead % CAPACITY] = metrics;
+		head.store(currentHead + 1, memory_order_release);
+	}
+
+	// Consumer only, false when the ring is empty
+	bool Pop(FrameMetrics &metrics) {
+		uint32_t currentTail = tail.load(memory_order_relaxed);
+		if (currentTail == head.load(memory_order_acquire)) {
+			return false;
+		}
+		metrics = frames[currentTail % CAPACITY];
+		tail.store(currentTail + 1, memory_order_release);
+		return true;
+	}
+
+	uint32_t TakeDropped() {
+		return dropped.exchange(0, memory_order_relaxed);
+	}
+
+private:
+	FrameMetrics frames[CAPACITY];
+	atomic<uint32_t> head;
+	atomic<uint32_t> tail;
+	atomic<uint32_t> dropped;
+};
+
+// Reporter thread draining the frame metrics the render loop records, every interval it writes one line of their
+// aggregates to standard output, or to a file, so the render loop never writes or flushes output itself
+class MetricsReporter {
+public:
+	MetricsReporter(MetricsFormat format, float interval) {
+		Format = format;
+		Interval = interval;
+		file = NULL;
+		isStopping = false;
+		ResetAggregates();
+	}
+
+	MetricsFormat Format;
+	float Interval;
+
+	// Start reporting to path, or to standard output when it is empty
+	bool Start(const string &path) {
+		file = path.empty() ? stdout : fopen(path.c_str(), "w");
+		if (file == NULL) {
+			cout << "ERROR::METRICS_REPORTER::FILE_NOT_OPENED " << path << endl;
+			return false;
+		}
+		if (Format == METRICS_CSV) {
+			fprintf(file, "frames,simulationStep,steps,maxReductions,dropped,meanDeltaTime,maxDeltaTime,timeStep,"
+				"meanSimulationTime,maxSimulationTime,meanRenderTime,maxRenderTime,renderScale\n");
+		}
+		reporter = thread(&MetricsReporter::Run, this);
+		return true;
+	}
+
+	// Render loop only, the frame is dropped when the reporter has fallen a whole ring behind
+	void Record(const FrameMetrics &metrics) {
+		ring.Push(metrics);
+	}
+
+	// Report the frames recorded since the last line and stop the reporter
+	void Stop() {
+		if (!reporter.joinable()) {
+			return;
+		}
+		isStopping.store(true);
+		reporter.join();
+		if (file != stdout) {
+			fclose(file);
+		}
+		file = NULL;
+	}
+
+private:
+	static const unsigned int RING_CAPACITY = 4096;
+
+	MetricsRing<RING_CAPACITY> ring;
+	thread reporter;
+	atomic<bool> isStopping;
+	FILE *file;
+
+	// Aggregates of the frames since the last line
+	uint32_t frames;
+	uint32_t steps;
+	uint32_t maxReductions;
+	uint32_t dropped;
+	double sumDeltaTime;
+	double sumSimulationTime;
+	double sumRenderTime;
+	float maxDeltaTime;
+	float maxSimulationTime;
+	float maxRenderTime;
+	FrameMetrics last;
+
+	void ResetAggregates() {
+		frames = 0;
+		steps = 0;
+		maxReductions = 0;
+		dropped = 0;
+		sumDeltaTime = 0.0;
+		sumSimulationTime = 0.0;
+		sumRenderTime = 0.0;
+		maxDeltaTime = 0.0f;
+		maxSimulationTime = 0.0f;
+		maxRenderTime = 0.0f;
+	}
+
+	void Drain() {
+		FrameMetrics metrics;
+		while (ring.Pop(metrics)) {
+			frames++;
+			steps += metrics.Steps;
+			maxReductions += metrics.MaxReductions;
+			sumDeltaTime += metrics.DeltaTime;
+			sumSimulationTime += metrics.SimulationTime;
+			sumRenderTime += metrics.RenderTime;
+			maxDeltaTime = max(maxDeltaTime, metrics.DeltaTime);
+			maxSimulationTime = max(maxSimulationTime, metrics.SimulationTime);
+			maxRenderTime = max(maxRenderTime, metrics.RenderTime);
+			last = metrics;
+		}
+	}
+
+	void Report() {
+		Drain();
+		dropped += ring.TakeDropped();
+		if (frames == 0) {
+			return;
+		}
+
+		const char *line = Format == METRICS_CSV ? "%u,%u,%u,%u,%u,%g,%g,%g,%g,%g,%g,%g,%g\n" :
+			"{\"frames\":%u,\"simulationStep\":%u,\"steps\":%u,\"maxReductions\":%u,\"dropped\":%u,\"meanDeltaTime\":%g,\"maxDeltaTime\":%g,"
+			"\"timeStep\":%g,\"meanSimulationTime\":%g,\"maxSimulationTime\":%g,\"meanRenderTime\":%g,\"maxRenderTime\":%g,\"renderScale\":%g}\n";
+		fprintf(file, line, frames, last.SimulationStep, steps, maxReductions, dropped, sumDeltaTime / frames, maxDeltaTime, last.TimeStep,
+			sumSimulationTime / frames, maxSimulationTime, sumRenderTime / frames, maxRenderTime, last.RenderScale);
+		fflush(file);
+		ResetAggregates();
+	}
+
+	void Run() {
+		chrono::steady_clock::time_point nextReport = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<float>(Interval));
+		while (!isStopping.load()) {
+			// Drain in between reports as well, so a long interval never fills the ring
+			this_thread::sleep_for(chrono::milliseconds(10));
+			Drain();
+			if (chrono::steady_clock::now() >= nextReport) {
+				Report();
+				nextReport += chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<float>(Interval));
+			}
+		}
+		Report();
+	}
+};
+#endif
\ No newline at end of file
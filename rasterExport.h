@@ -0,0 +1,272 @@
+#ifndef RASTER_EXPORT_H
+#define RASTER_EXPORT_H
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum RasterExportFormat { EXPORT_PNG16, EXPORT_RAW_FLOAT32, EXPORT_HALF_EXR };
+
+// Writes the four channels of an RGBA32F texture as rasters a row of the grid per image row, in one of three formats
+// EXPORT_PNG16 writes a 16-bit grayscale PNG per channel, quantized between the channel's minimum and maximum, which are kept in
+// the "Minimum" and "Maximum" text chunks. EXPORT_RAW_FLOAT32 writes the channels interleaved as raw little endian floats with an
+// ENVI header beside them. EXPORT_HALF_EXR writes an uncompressed OpenEXR image of half float channels, converted by the read back
+class RasterExporter {
+public:
+	RasterExportFormat Format;
+
+	RasterExporter(RasterExportFormat format) {
+		Format = format;
+	}
+
+	// Write the texture to files starting with path, channelNames names the red, green, blue and alpha channels
+	bool Export(unsigned int textureID, unsigned int width, unsigned int height, const string &path, const char *const channelNames[4]) {
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+		if (Format == EXPORT_HALF_EXR) {
+			vector<uint16_t> texels((size_t)width * height * 4);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_HALF_FLOAT, &texels[0]);
+			return WriteExr(path + ".exr", texels, width, height, channelNames);
+		}
+
+		vector<float> texels((size_t)width * height * 4);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, &texels[0]);
+
+		if (Format == EXPORT_RAW_FLOAT32) {
+			return WriteRaw(path, texels, width, height, channelNames);
+		}
+
+		for (unsigned int channel = 0; channel < 4; channel++) {
+			if (!WritePng16(path + "_" + channelNames[channel] + ".png", texels, width, height, channel)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	static FILE* OpenFile(const string &path) {
+		FILE *file = fopen(path.c_str(), "wb");
+		if (file == NULL) {
+			cout << "ERROR::RASTER_EXPORTER::FILE_NOT_OPENED " << path << endl;
+		}
+		return file;
+	}
+
+	static bool CloseFile(FILE *file, const string &path) {
+		bool isWritten = !ferror(file);
+		isWritten = fclose(file) == 0 && isWritten;
+		if (!isWritten) {
+			cout << "ERROR::RASTER_EXPORTER::FILE_NOT_WRITTEN " << path << endl;
+		}
+		return isWritten;
+	}
+
+	static void Append(vector<unsigned char> &bytes, const void *data, size_t size) {
+		bytes.insert(bytes.end(), (const unsigned char*)data, (const unsigned char*)data + size);
+	}
+
+	static void AppendLittle(vector<unsigned char> &bytes, uint64_t value, unsigned int size) {
+		for (unsigned int i = 0; i < size; i++) {
+			bytes.push_back((unsigned char)(value >> (8 * i)));
+		}
+	}
+
+	static void AppendBig(vector<unsigned char> &bytes, uint32_t value) {
+		for (int i = 3; i >= 0; i--) {
+			bytes.push_back((unsigned char)(value >> (8 * i)));
+		}
+	}
+
+	bool WriteRaw(const string &path, const vector<float> &texels, unsigned int width, unsigned int height, const char *const channelNames[4]) {
+		FILE *file = OpenFile(path + ".raw");
+		if (file == NULL) {
+			return false;
+		}
+		fwrite(&texels[0], sizeof(float), texels.size(), file);
+		if (!CloseFile(file, path + ".raw")) {
+			return false;
+		}
+
+		// ENVI header, band interleaved by pixel 32-bit floats in little endian byte order
+		file = OpenFile(path + ".hdr");
+		if (file == NULL) {
+			return false;
+		}
+		fprintf(file, "ENVI\nsamples = %u\nlines = %u\nbands = 4\nheader offset = 0\nfile type = ENVI Standard\n", width, height);
+		fprintf(file, "data type = 4\ninterleave = bip\nbyte order = 0\n");
+		fprintf(file, "band names = { %s, %s, %s, %s }\n", channelNames[0], channelNames[1], channelNames[2], channelNames[3]);
+		return CloseFile(file, path + ".hdr");
+	}
+
+	static uint32_t Crc32(const unsigned char *data, size_t size, uint32_t crc = 0) {
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+			}
+		}
+		return ~crc;
+	}
+
+	static void AppendPngChunk(vector<unsigned char> &png, const char *type, const vector<unsigned char> &data) {
+		AppendBig(png, (uint32_t)data.size());
+		size_t typeStart = png.size();
+		Append(png, type, 4);
+		if (!data.empty()) {
+			Append(png, &data[0], data.size());
+		}
+		AppendBig(png, Crc32(&png[typeStart], png.size() - typeStart));
+	}
+
+	static void AppendPngText(vector<unsigned char> &png, const char *keyword, float value) {
+		char text[64];
+		int length = snprintf(text, sizeof(text), "%s%c%.9g", keyword, '\0', value);
+		AppendPngChunk(png, "tEXt", vector<unsigned char>(text, text + length));
+	}
+
+	// The image data is stored in uncompressed deflate blocks, there is no deflate encoder in the project
+	bool WritePng16(const string &path, const vector<float> &texels, unsigned int width, unsigned int height, unsigned int channel) {
+		float minimum = texels[channel];
+		float maximum = texels[channel];
+		for (size_t texel = channel; texel < texels.size(); texel += 4) {
+			minimum = min(minimum, texels[texel]);
+			maximum = max(maximum, texels[texel]);
+		}
+		float scale = maximum > minimum ? 65535.0f / (maximum - minimum) : 0.0f;
+
+		// Filter type 0 and big endian samples on every row
+		vector<unsigned char> rows;
+		rows.reserve((size_t)height * (1 + width * 2));
+		for (unsigned int j = 0; j < height; j++) {
+			rows.push_back(0);
+			for (unsigned int i = 0; i < width; i++) {
+				uint16_t sample = (uint16_t)((texels[((size_t)i + (size_t)j * width) * 4 + channel] - minimum) * scale + 0.5f);
+				rows.push_back((unsigned char)(sample >> 8));
+				rows.push_back((unsigned char)sample);
+			}
+		}
+
+		vector<unsigned char> zlib;
+		zlib.push_back(0x78);
+		zlib.push_back(0x01);
+		for (size_t start = 0; start < rows.size() || start == 0; start += 65535) {
+			uint16_t blockSize = (uint16_t)min((size_t)65535, rows.size() - start);
+			zlib.push_back(start + blockSize == rows.size() ? 1 : 0);
+			AppendLittle(zlib, blockSize, 2);
+			AppendLittle(zlib, (uint16_t)~blockSize, 2);
+			Append(zlib, &rows[start], blockSize);
+		}
+		uint32_t a = 1, b = 0;
+		for (size_t i = 0; i < rows.size(); i++) {
+			a = (a + rows[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		AppendBig(zlib, (b << 16) | a);
+
+		vector<unsigned char> header;
+		AppendBig(header, width);
+		AppendBig(header, height);
+		const unsigned char format[5] = { 16, 0, 0, 0, 0 }; // 16-bit grayscale, deflate, adaptive filtering, no interlace
+		Append(header, format, 5);
+
+		vector<unsigned char> png;
+		const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+		Append(png, signature, 8);
+		AppendPngChunk(png, "IHDR", header);
+		AppendPngText(png, "Minimum", minimum);
+		AppendPngText(png, "Maximum", maximum);
+		AppendPngChunk(png, "IDAT", zlib);
+		AppendPngChunk(png, "IEND", vector<unsigned char>());
+
+		FILE *file = OpenFile(path);
+		if (file == NULL) {
+			return false;
+		}
+		fwrite(&png[0], 1, png.size(), file);
+		return CloseFile(file, path);
+	}
+
+	static void AppendExrAttribute(vector<unsigned char> &exr, const char *name, const char *type, const vector<unsigned char> &value) {
+		Append(exr, name, strlen(name) + 1);
+		Append(exr, type, strlen(type) + 1);
+		AppendLittle(exr, value.size(), 4);
+		Append(exr, &value[0], value.size());
+	}
+
+	// Single part scan line image without compression, one scan line per block
+	bool WriteExr(const string &path, const vector<uint16_t> &texels, unsigned int width, unsigned int height, const char *const channelNames[4]) {
+		// Channels are listed, and stored in every scan line, in alphabetical order
+		unsigned int order[4] = { 0, 1, 2, 3 };
+		sort(order, order + 4, [&](unsigned int x, unsigned int y) { return strcmp(channelNames[x], channelNames[y]) < 0; });
+
+		vector<unsigned char> exr;
+		AppendLittle(exr, 20000630, 4);
+		AppendLittle(exr, 2, 4);
+
+		vector<unsigned char> channels;
+		for (unsigned int c = 0; c < 4; c++) {
+			Append(channels, channelNames[order[c]], strlen(channelNames[order[c]]) + 1);
+			AppendLittle(channels, 1, 4); // HALF
+			AppendLittle(channels, 0, 4); // Not perceptually linear, reserved
+			AppendLittle(channels, 1, 4); // x sampling
+			AppendLittle(channels, 1, 4); // y sampling
+		}
+		channels.push_back(0);
+		AppendExrAttribute(exr, "channels", "chlist", channels);
+
+		AppendExrAttribute(exr, "compression", "compression", vector<unsigned char>(1, 0));
+		vector<unsigned char> window;
+		AppendLittle(window, 0, 4);
+		AppendLittle(window, 0, 4);
+		AppendLittle(window, width - 1, 4);
+		AppendLittle(window, height - 1, 4);
+		AppendExrAttribute(exr, "dataWindow", "box2i", window);
+		AppendExrAttribute(exr, "displayWindow", "box2i", window);
+		AppendExrAttribute(exr, "lineOrder", "lineOrder", vector<unsigned char>(1, 0));
+		float one = 1.0f;
+		vector<unsigned char> oneValue((unsigned char*)&one, (unsigned char*)&one + 4);
+		AppendExrAttribute(exr, "pixelAspectRatio", "float", oneValue);
+		AppendExrAttribute(exr, "screenWindowCenter", "v2f", vector<unsigned char>(8, 0));
+		AppendExrAttribute(exr, "screenWindowWidth", "float", oneValue);
+		exr.push_back(0);
+
+		// Offset table of the scan line blocks, each holding its y, its size and its channels
+		uint32_t blockSize = 8 + width * 4 * 2;
+		uint64_t firstBlock = exr.size() + (uint64_t)height * 8;
+		for (unsigned int j = 0; j < height; j++) {
+			AppendLittle(exr, firstBlock + (uint64_t)j * blockSize, 8);
+		}
+
+		FILE *file = OpenFile(path);
+		if (file == NULL) {
+			return false;
+		}
+		fwrite(&exr[0], 1, exr.size(), file);
+
+		vector<unsigned char> block;
+		for (unsigned int j = 0; j < height; j++) {
+			block.clear();
+			AppendLittle(block, j, 4);
+			AppendLittle(block, width * 4 * 2, 4);
+			for (unsigned int c = 0; c < 4; c++) {
+				for (unsigned int i = 0; i < width; i++) {
+					AppendLittle(block, texels[((size_t)i + (size_t)j * width) * 4 + order[c]], 2);
+				}
+			}
+			fwrite(&block[0], 1, block.size(), file);
+		}
+		return CloseFile(file, path);
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,438 @@
+#ifndef RASTER_IMPORT_H
+#define RASTER_IMPORT_H
+
+#include <glm/glm.hpp>
+
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum RasterSampleType { RASTER_UINT8, RASTER_UINT16, RASTER_INT16, RASTER_UINT32, RASTER_INT32, RASTER_FLOAT32 };
+
+// Share of the largest vegetation height growing on a class of a land cover raster
+struct LandCoverVegetation {
+	float LandCoverClass;
+	float VegetationFraction;
+};
+
+// Single band raster read one row at a time, so a raster larger than memory is only ever held a row at a time
+// Rasters are told apart by extension: .tif/.tiff are uncompressed GeoTIFF strips or tiles, .png is read through stb_image
+// (which can only decode whole images), and anything else is a raw little endian grid whose layout is given to Open
+class RasterReader {
+public:
+	unsigned int Width;
+	unsigned int Height;
+
+	RasterReader() {
+		Width = 0;
+		Height = 0;
+		file = NULL;
+		sampleType = RASTER_UINT16;
+		isBigEndian = false;
+		rowsPerStrip = 0;
+		tileWidth = 0;
+		tileHeight = 0;
+	}
+
+	~RasterReader() {
+		Close();
+	}
+
+	bool Open(const string &path, RasterSampleType rawSampleType, unsigned int rawWidth, unsigned int rawHeight) {
+		Close();
+
+		string extension = path.substr(path.find_last_of('.') + 1);
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+		if (extension == "png") {
+			int width, height, channels;
+			unsigned short *pixels = stbi_load_16(path.c_str(), &width, &height, &channels, 1);
+			if (pixels == NULL) {
+				cout << "ERROR::RASTER_READER::IMAGE_NOT_LOADED " << path << endl;
+				return false;
+			}
+			image.assign(pixels, pixels + (size_t)width * height);
+			stbi_image_free(pixels);
+
+			Width = width;
+			Height = height;
+			return true;
+		}
+
+		file = fopen(path.c_str(), "rb");
+		if (file == NULL) {
+			cout << "ERROR::RASTER_READER::FILE_NOT_OPENED " << path << endl;
+			return false;
+		}
+
+		if (extension == "tif" || extension == "tiff") {
+			if (!ReadTiffDirectory()) {
+				cout << "ERROR::RASTER_READER::TIFF_NOT_SUPPORTED " << path << endl;
+				Close();
+				return false;
+			}
+		}
+		else {
+			// A raw grid is a single strip of every row
+			Width = rawWidth;
+			Height = rawHeight;
+			sampleType = rawSampleType;
+			isBigEndian = false;
+			rowsPerStrip = rawHeight;
+			blockOffsets.assign(1, 0);
+		}
+
+		rowBytes.resize((size_t)(tileWidth > 0 ? tileWidth : Width) * SampleSize());
+		return true;
+	}
+
+	// Read the samples of a row, values holds Width floats
+	bool ReadRow(unsigned int row, float *values) {
+		if (!image.empty()) {
+			for (unsigned int i = 0; i < Width; i++) {
+				values[i] = image[(size_t)row * Width + i];
+			}
+			return true;
+		}
+
+		if (tileWidth == 0) {
+			unsigned int strip = row / rowsPerStrip;
+			uint64_t offset = blockOffsets[strip] + (uint64_t)(row % rowsPerStrip) * Width * SampleSize();
+			return ReadSamples(offset, Width, values);
+		}
+
+		// A tiled row runs through one row of every tile across
+		unsigned int tilesAcross = (Width + tileWidth - 1) / tileWidth;
+		unsigned int tileRow = row / tileHeight;
+		for (unsigned int tile = 0; tile < tilesAcross; tile++) {
+			uint64_t offset = blockOffsets[tileRow * tilesAcross + tile] + (uint64_t)(row % tileHeight) * tileWidth * SampleSize();
+			unsigned int samples = min(tileWidth, Width - tile * tileWidth);
+			if (!ReadSamples(offset, samples, values + tile * tileWidth)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Close() {
+		if (file != NULL) {
+			fclose(file);
+			file = NULL;
+		}
+		vector<unsigned short>().swap(image);
+		blockOffsets.clear();
+		tileWidth = 0;
+		tileHeight = 0;
+	}
+
+private:
+	FILE *file;
+	vector<unsigned short> image;
+	RasterSampleType sampleType;
+	bool isBigEndian;
+
+	// Strips of rowsPerStrip rows, or tiles of tileWidth x tileHeight samples row by row
+	vector<uint64_t> blockOffsets;
+	unsigned int rowsPerStrip;
+	unsigned int tileWidth;
+	unsigned int tileHeight;
+
+	vector<unsigned char> rowBytes;
+
+	unsigned int SampleSize() const {
+		switch (sampleType) {
+		case RASTER_UINT8:
+			return 1;
+		case RASTER_UINT16:
+		case RASTER_INT16:
+			return 2;
+		default:
+			return 4;
+		}
+	}
+
+	bool Seek(uint64_t offset) {
+#ifdef _WIN32
+		return _fseeki64(file, (long long)offset, SEEK_SET) == 0;
+#else
+		return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+	}
+
+	uint64_t Tell() {
+#ifdef _WIN32
+		return (uint64_t)_ftelli64(file);
+#else
+		return (uint64_t)ftello(file);
+#endif
+	}
+
+	uint32_t Unpack(const unsigned char *bytes, unsigned int size) const {
+		uint32_t value = 0;
+		for (unsigned int i = 0; i < size; i++) {
+			value |= (uint32_t)bytes[isBigEndian ? size - 1 - i : i] << (8 * i);
+		}
+		return value;
+	}
+
+	bool ReadSamples(uint64_t offset, unsigned int samples, float *values) {
+		unsigned int size = SampleSize();
+		if (!Seek(offset) || fread(&rowBytes[0], size, samples, file) != samples) {
+			cout << "ERROR::RASTER_READER::ROW_NOT_READ" << endl;
+			return false;
+		}
+
+		for (unsigned int i = 0; i < samples; i++) {
+			uint32_t bits = Unpack(&rowBytes[(size_t)i * size], size);
+			switch (sampleType) {
+			case RASTER_UINT8:
+			case RASTER_UINT16:
+			case RASTER_UINT32:
+				values[i] = (float)bits;
+				break;
+			case RASTER_INT16:
+				values[i] = (float)(int16_t)bits;
+				break;
+			case RASTER_INT32:
+				values[i] = (float)(int32_t)bits;
+				break;
+			case RASTER_FLOAT32:
+				memcpy(&values[i], &bits, sizeof(float));
+				break;
+			}
+		}
+		return true;
+	}
+
+	// Values of a directory entry, held in the entry itself when they fit in its four bytes
+	bool ReadTiffValues(const unsigned char *entry, vector<uint64_t> &values) {
+		unsigned int type = Unpack(entry + 2, 2);
+		uint32_t count = Unpack(entry + 4, 4);
+		unsigned int size = type == 3 ? 2 : type == 4 ? 4 : type == 1 ? 1 : 0;
+		if (size == 0) {
+			return false;
+		}
+
+		vector<unsigned char> bytes((size_t)count * size);
+		if (bytes.size() <= 4) {
+			memcpy(&bytes[0], entry + 8, bytes.size());
+		}
+		else {
+			uint64_t position = Tell();
+			if (!Seek(Unpack(entry + 8, 4)) || fread(&bytes[0], 1, bytes.size(), file) != bytes.size() || !Seek(position)) {
+				return false;
+			}
+		}
+
+		values.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			values[i] = Unpack(&bytes[(size_t)i * size], size);
+		}
+		return true;
+	}
+
+	// The first image of a classic TIFF with one uncompressed sample per pixel
+	bool ReadTiffDirectory() {
+		unsigned char header[8];
+		if (fread(header, 1, 8, file) != 8 || (memcmp(header, "II", 2) != 0 && memcmp(header, "MM", 2) != 0)) {
+			return false;
+		}
+		isBigEndian = header[0] == 'M';
+		if (Unpack(header + 2, 2) != 42 || !Seek(Unpack(header + 4, 4))) {
+			return false;
+		}
+
+		unsigned char countBytes[2];
+		if (fread(countBytes, 1, 2, file) != 2) {
+			return false;
+		}
+		unsigned int entries = Unpack(countBytes, 2);
+
+		unsigned int bitsPerSample = 1;
+		unsigned int sampleFormat = 1;
+		unsigned int compression = 1;
+		unsigned int samplesPerPixel = 1;
+		rowsPerStrip = 0xffffffff;
+		for (unsigned int e = 0; e < entries; e++) {
+			unsigned char entry[12];
+			vector<uint64_t> values;
+			if (fread(entry, 1, 12, file) != 12) {
+				return false;
+			}
+
+			unsigned int tag = Unpack(entry, 2);
+			if (tag == 256 || tag == 257 || tag == 258 || tag == 259 || tag == 273 || tag == 277 || tag == 278 || tag == 322 || tag == 323 || tag == 324 || tag == 339) {
+				if (!ReadTiffValues(entry, values) || values.empty()) {
+					return false;
+				}
+			}
+
+			switch (tag) {
+			case 256: Width = (unsigned int)values[0]; break;
+			case 257: Height = (unsigned int)values[0]; break;
+			case 258: bitsPerSample = (unsigned int)values[0]; break;
+			case 259: compression = (unsigned int)values[0]; break;
+			case 273: blockOffsets = values; break; // Strip offsets
+			case 277: samplesPerPixel = (unsigned int)values[0]; break;
+			case 278: rowsPerStrip = (unsigned int)values[0]; break;
+			case 322: tileWidth = (unsigned int)values[0]; break;
+			case 323: tileHeight = (unsigned int)values[0]; break;
+			case 324: blockOffsets = values; break; // Tile offsets
+			case 339: sampleFormat = (unsigned int)values[0]; break;
+			}
+		}
+
+		if (compression != 1 || samplesPerPixel != 1 || Width == 0 || Height == 0 || rowsPerStrip == 0 || (tileWidth == 0) != (tileHeight == 0)) {
+			return false;
+		}
+		rowsPerStrip = min(rowsPerStrip, Height);
+
+		// Every strip, or every tile across and down, needs its offset
+		uint64_t blocks = ((uint64_t)Height + rowsPerStrip - 1) / rowsPerStrip;
+		if (tileWidth != 0) {
+			blocks = (((uint64_t)Width + tileWidth - 1) / tileWidth) * (((uint64_t)Height + tileHeight - 1) / tileHeight);
+		}
+		if (blockOffsets.size() < blocks) {
+			return false;
+		}
+
+		if (sampleFormat == 3 && bitsPerSample == 32) {
+			sampleType = RASTER_FLOAT32;
+		}
+		else if (sampleFormat == 2 && (bitsPerSample == 16 || bitsPerSample == 32)) {
+			sampleType = bitsPerSample == 16 ? RASTER_INT16 : RASTER_INT32;
+		}
+		else if (sampleFormat == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 32)) {
+			sampleType = bitsPerSample == 8 ? RASTER_UINT8 : bitsPerSample == 16 ? RASTER_UINT16 : RASTER_UINT32;
+		}
+		else {
+			return false;
+		}
+
+		return true;
+	}
+};
+
+// Resamples a raster to a grid row by row, reading every raster row once in order
+// A raster larger than the grid is box filtered over the raster samples in every cell, a smaller one is interpolated
+// bilinearly between the cell centers, and a categorical raster takes the sample nearest to every cell center
+class RasterResampler {
+public:
+	// No data samples count as 0, sea level for most elevation rasters
+	RasterResampler(RasterReader &reader, unsigned int gridWidth, unsigned int gridHeight, bool isCategorical, float noDataValue) : reader(reader) {
+		this->gridWidth = gridWidth;
+		this->gridHeight = gridHeight;
+		this->isCategorical = isCategorical;
+		this->noDataValue = noDataValue;
+		isBoxFiltered = !isCategorical && reader.Width >= gridWidth && reader.Height >= gridHeight;
+		nextGridRow = 0;
+
+		rows[0].resize(reader.Width);
+		rows[1].resize(reader.Width);
+		rowIndices[0] = rowIndices[1] = -1;
+	}
+
+	// Resample the next grid row into values, which holds gridWidth floats
+	bool ReadGridRow(float *values) {
+		unsigned int j = nextGridRow++;
+
+		if (isBoxFiltered) {
+			vector<double> sums(gridWidth, 0.0);
+			vector<unsigned int> counts(gridWidth, 0);
+
+			unsigned int firstRow = (unsigned int)((uint64_t)j * reader.Height / gridHeight);
+			unsigned int endRow = max(firstRow + 1, (unsigned int)((uint64_t)(j + 1) * reader.Height / gridHeight));
+			for (unsigned int row = firstRow; row < endRow; row++) {
+				if (!ReadRow(0, row)) {
+					return false;
+				}
+				for (unsigned int x = 0; x < reader.Width; x++) {
+					unsigned int i = (unsigned int)((uint64_t)x * gridWidth / reader.Width);
+					sums[i] += rows[0][x];
+					counts[i]++;
+				}
+			}
+
+			for (unsigned int i = 0; i < gridWidth; i++) {
+				values[i] = (float)(sums[i] / max(1u, counts[i]));
+			}
+			return true;
+		}
+
+		if (isCategorical) {
+			if (!ReadRow(0, NearestSample(j, gridHeight, reader.Height))) {
+				return false;
+			}
+			for (unsigned int i = 0; i < gridWidth; i++) {
+				values[i] = rows[0][NearestSample(i, gridWidth, reader.Width)];
+			}
+			return true;
+		}
+
+		float y = glm::clamp(((float)j + 0.5f) * reader.Height / gridHeight - 0.5f, 0.0f, (float)(reader.Height - 1));
+		unsigned int y0 = (unsigned int)y;
+		unsigned int y1 = min(y0 + 1, reader.Height - 1);
+		if (!ReadRow(0, y0) || !ReadRow(1, y1)) {
+			return false;
+		}
+
+		for (unsigned int i = 0; i < gridWidth; i++) {
+			float x = glm::clamp(((float)i + 0.5f) * reader.Width / gridWidth - 0.5f, 0.0f, (float)(reader.Width - 1));
+			unsigned int x0 = (unsigned int)x;
+			unsigned int x1 = min(x0 + 1, reader.Width - 1);
+
+			float bottom = glm::mix(rows[0][x0], rows[0][x1], x - x0);
+			float top = glm::mix(rows[1][x0], rows[1][x1], x - x0);
+			values[i] = glm::mix(bottom, top, y - y0);
+		}
+		return true;
+	}
+
+private:
+	RasterReader &reader;
+	unsigned int gridWidth;
+	unsigned int gridHeight;
+	bool isCategorical;
+	bool isBoxFiltered;
+	float noDataValue;
+	unsigned int nextGridRow;
+
+	// The last two raster rows read, grid rows only move forward so a row is never read twice
+	vector<float> rows[2];
+	long long rowIndices[2];
+
+	static unsigned int NearestSample(unsigned int cell, unsigned int cells, unsigned int samples) {
+		return min(samples - 1, (unsigned int)(((uint64_t)cell * 2 + 1) * samples / (2 * (uint64_t)cells)));
+	}
+
+	bool ReadRow(unsigned int slot, unsigned int row) {
+		if (rowIndices[slot] == row) {
+			return true;
+		}
+		if (rowIndices[1 - slot] == row) {
+			rows[slot] = rows[1 - slot];
+			rowIndices[slot] = row;
+			return true;
+		}
+
+		if (!reader.ReadRow(row, &rows[slot][0])) {
+			return false;
+		}
+		for (unsigned int x = 0; x < reader.Width; x++) {
+			if (rows[slot][x] == noDataValue) {
+				rows[slot][x] = 0.0f;
+			}
+		}
+		rowIndices[slot] = row;
+		return true;
+	}
+};
+#endif
\ No newline at end of file
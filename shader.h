@@ -1,268 +1,363 @@
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <glad/glad.h>
-#include <glm/glm.hpp>
-
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-
-using namespace std;
-
-class Shader {
-public:
-	// the program ID;
-	unsigned int ID;
-
-	// constructor reads and builds the shader program from given compute shader
-	Shader(const GLchar* computePath) {
-		// 1. Retrieve the vertex/fragment source code from filePath
-		string computeCode;
-		ifstream cShaderFile;
-
-		// ensure ifstream objects can thrown exceptions
-		cShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
-
-		try {
-			// open files
-			cShaderFile.open(computePath);
-			stringstream cShaderStream;
-
-			// read file's buffer contents into streams
-			cShaderStream << cShaderFile.rdbuf();
-
-			// close file handlers
-			cShaderFile.close();
-
-			// convert stream into string
-			computeCode = cShaderStream.str();
-		}
-		catch (ifstream::failure e) {
-			cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << endl;
-		}
-
-		const char* cShaderCode = computeCode.c_str();
-
-		// 2. Compile shaders
-		unsigned int compute;
-
-		// vertex shader
-		compute = glCreateShader(GL_COMPUTE_SHADER);
-		glShaderSource(compute, 1, &cShaderCode, NULL);
-		glCompileShader(compute);
-		// print compile errors if any
-		checkCompileErrors(compute, "COMPUTE");
-
-		// shader program
-		ID = glCreateProgram();
-		glAttachShader(ID, compute);
-		glLinkProgram(ID);
-		// print linking errors if any
-		checkCompileErrors(ID, "PROGRAM");
-
-		// delete the shaders as they're linked into our program now and no longer necessary
-		glDeleteShader(compute);
-	}
-
-	// constructor reads and builds the shader program from given vertex, fragment, and geometry shaders
-	Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath = nullptr) {
-		// 1. Retrieve the vertex/fragment source code from filePath
-		string vertexCode;
-		string fragmentCode;
-		string geometryCode;
-		ifstream vShaderFile;
-		ifstream fShaderFile;
-		ifstream gShaderFile;
-
-		// ensure ifstream objects can thrown exceptions
-		vShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
-		fShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
-		gShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
-
-		try {
-			// open files
-			vShaderFile.open(vertexPath);
-			fShaderFile.open(fragmentPath);
-			stringstream vShaderStream, fShaderStream;
-
-			// read file's buffer contents into streams
-			vShaderStream << vShaderFile.rdbuf();
-			fShaderStream << fShaderFile.rdbuf();
-
-			// close file handlers
-			vShaderFile.close();
-			fShaderFile.close();
-
-			// convert stream into string
-			vertexCode = vShaderStream.str();
-			fragmentCode = fShaderStream.str();
-
-			// if geometry shader path is present, also load a geometry shader
-			if (geometryPath != nullptr) {
-				gShaderFile.open(geometryPath);
-				stringstream gShaderStream;
-				gShaderStream << gShaderFile.rdbuf();
-				gShaderFile.close();
-				geometryCode = gShaderStream.str();
-			}
-		}
-		catch (ifstream::failure e) {
-			cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << endl;
-		}
-
-		const char* vShaderCode = vertexCode.c_str();
-		const char* fShaderCode = fragmentCode.c_str();
-
-		// 2. Compile shaders
-		unsigned int vertex, fragment;
-
-		// vertex shader
-		vertex = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertex, 1, &vShaderCode, NULL);
-		glCompileShader(vertex);
-		// print compile errors if any
-		checkCompileErrors(vertex, "VERTEX");
-
-		// fragment shader
-		fragment = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragment, 1, &fShaderCode, NULL);
-		glCompileShader(fragment);
-		// print compile errors if any
-		checkCompileErrors(fragment, "FRAGMENT");
-
-		// if geometry shader is given, compile geometry shader
-		unsigned int geometry;
-		if (geometryPath != nullptr) {			
-			const GLchar* gShaderCode = geometryCode.c_str();
-			geometry = glCreateShader(GL_GEOMETRY_SHADER);
-			glShaderSource(geometry, 1, &gShaderCode, NULL);
-			glCompileShader(geometry);
-			checkCompileErrors(geometry, "GEOMETRY");
-		}
-
-		// shader program
-		ID = glCreateProgram();
-		glAttachShader(ID, vertex);
-		glAttachShader(ID, fragment);
-		if (geometryPath != nullptr) {
-			glAttachShader(ID, geometry);
-		}
-		glLinkProgram(ID);
-		// print linking errors if any
-		checkCompileErrors(ID, "PROGRAM");
-
-		// delete the shaders as they're linked into our program now and no longer necessary
-		glDeleteShader(vertex);
-		glDeleteShader(fragment);
-		if (geometryPath != nullptr) {
-			glDeleteShader(geometry);
-		}
-	}
-	// use/activate the shader
-	void use() {
-		glUseProgram(ID);
-	}
-	// utility uniform functions
-	void setBool(const string &name, bool value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
-	}
-
-	void setInt(const string &name, int value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	void setFloat(const string &name, float value) const {
-		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	void setVec2(const string &name, const glm::vec2 &value) const {
-		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setVec2(const string &name, float x, float y) const {
-		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
-	}
-
-	void setIVec2(const string &name, const glm::ivec2 &value) const {
-		glUniform2iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setIVec2(const string &name, int x, int y) const {
-		glUniform2i(glGetUniformLocation(ID, name.c_str()), x, y);
-	}
-
-	void setVec3(const string &name, const glm::vec3 &value) const {
-		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setVec3(const string &name, float x, float y, float z) const {
-		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
-	}
-
-	void setIVec3(const string &name, const glm::ivec3 &value) const {
-		glUniform3iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setIVec3(const string &name, int x, int y, int z) const {
-		glUniform3i(glGetUniformLocation(ID, name.c_str()), x, y, z);
-	}
-
-	void setVec4(const string &name, const glm::vec4 &value) const {
-		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setVec4(const string &name, float x, float y, float z, float w) const {
-		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
-	}
-
-	void setIVec4(const string &name, const glm::ivec4 &value) const {
-		glUniform4iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-
-	void setIVec4(const string &name, int x, int y, int z, int w) const {
-		glUniform4i(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
-	}
-
-	void setMat2(const string &name, const glm::mat2 &mat) const {
-		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-
-	void setMat3(const string &name, const glm::mat3 &mat) const {
-		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-
-	void setMat4(const string &name, const glm::mat4 &mat) const {
-		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-
-private:
-	// utility function for checking shader compilation/linking errors.
-	// ------------------------------------------------------------------------
-	void checkCompileErrors(GLuint shader, std::string type)
-	{
-		GLint success;
-		GLchar infoLog[1024];
-		if (type != "PROGRAM")
-		{
-			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-			if (!success)
-			{
-				glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-				std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-			}
-		}
-		else
-		{
-			glGetProgramiv(shader, GL_LINK_STATUS, &success);
-			if (!success)
-			{
-				glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-				std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
-			}
-		}
-	}
-};
-
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// A program is compiled and linked without waiting for either, so with GL_KHR_parallel_shader_compile the driver builds all
+// the programs constructed in a row on its threads. Its errors are checked when it is first used. With a cache directory set,
+// the linked binary of every program is kept in it, named by a hash of the driver and the sources, and loaded instead of
+// compiling the program on later runs
+class Shader {
+public:
+	// the program ID;
+	unsigned int ID;
+
+	// directory of the program binaries, which must exist, none when empty
+	static string &CacheDirectory() {
+		static string cacheDirectory;
+		return cacheDirectory;
+	}
+
+	// constructor reads and builds the shader program from given compute shader
+	Shader(const GLchar* computePath) {
+		// 1. Retrieve the vertex/fragment source code from filePath
+		string computeCode;
+		ifstream cShaderFile;
+
+		// ensure ifstream objects can thrown exceptions
+		cShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
+
+		try {
+			// open files
+			cShaderFile.open(computePath);
+			stringstream cShaderStream;
+
+			// read file's buffer contents into streams
+			cShaderStream << cShaderFile.rdbuf();
+
+			// close file handlers
+			cShaderFile.close();
+
+			// convert stream into string
+			computeCode = cShaderStream.str();
+		}
+		catch (ifstream::failure e) {
+			cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << endl;
+		}
+
+		// 2. Compile shaders
+		const GLenum types[1] = { GL_COMPUTE_SHADER };
+		build(types, &computeCode, 1);
+	}
+
+	// constructor reads and builds the shader program from given vertex, fragment, and geometry shaders
+	Shader(const GLchar* vertexPath, const GLchar* fragmentPath, const GLchar* geometryPath = nullptr) {
+		// 1. Retrieve the vertex/fragment source code from filePath
+		string vertexCode;
+		string fragmentCode;
+		string geometryCode;
+		ifstream vShaderFile;
+		ifstream fShaderFile;
+		ifstream gShaderFile;
+
+		// ensure ifstream objects can thrown exceptions
+		vShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
+		fShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
+		gShaderFile.exceptions(ifstream::failbit | ifstream::badbit);
+
+		try {
+			// open files
+			vShaderFile.open(vertexPath);
+			fShaderFile.open(fragmentPath);
+			stringstream vShaderStream, fShaderStream;
+
+			// read file's buffer contents into streams
+			vShaderStream << vShaderFile.rdbuf();
+			fShaderStream << fShaderFile.rdbuf();
+
+			// close file handlers
+			vShaderFile.close();
+			fShaderFile.close();
+
+			// convert stream into string
+			vertexCode = vShaderStream.str();
+			fragmentCode = fShaderStream.str();
+
+			// if geometry shader path is present, also load a geometry shader
+			if (geometryPath != nullptr) {
+				gShaderFile.open(geometryPath);
+				stringstream gShaderStream;
+				gShaderStream << gShaderFile.rdbuf();
+				gShaderFile.close();
+				geometryCode = gShaderStream.str();
+			}
+		}
+		catch (ifstream::failure e) {
+			cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << endl;
+		}
+
+		// 2. Compile shaders, the geometry shader only if it is given
+		const GLenum types[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+		const string codes[3] = { vertexCode, fragmentCode, geometryCode };
+		build(types, codes, geometryPath != nullptr ? 3 : 2);
+	}
+	// use/activate the shader
+	void use() {
+		if (isPending) {
+			finish();
+		}
+		glUseProgram(ID);
+	}
+	// utility uniform functions
+	void setBool(const string &name, bool value) const {
+		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+	}
+
+	void setInt(const string &name, int value) const {
+		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+	}
+
+	void setFloat(const string &name, float value) const {
+		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+	}
+
+	void setVec2(const string &name, const glm::vec2 &value) const {
+		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setVec2(const string &name, float x, float y) const {
+		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+	}
+
+	void setIVec2(const string &name, const glm::ivec2 &value) const {
+		glUniform2iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setIVec2(const string &name, int x, int y) const {
+		glUniform2i(glGetUniformLocation(ID, name.c_str()), x, y);
+	}
+
+	void setVec3(const string &name, const glm::vec3 &value) const {
+		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setVec3(const string &name, float x, float y, float z) const {
+		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+	}
+
+	void setIVec3(const string &name, const glm::ivec3 &value) const {
+		glUniform3iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setIVec3(const string &name, int x, int y, int z) const {
+		glUniform3i(glGetUniformLocation(ID, name.c_str()), x, y, z);
+	}
+
+	void setVec4(const string &name, const glm::vec4 &value) const {
+		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setVec4(const string &name, float x, float y, float z, float w) const {
+		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+	}
+
+	void setIVec4(const string &name, const glm::ivec4 &value) const {
+		glUniform4iv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+
+	void setIVec4(const string &name, int x, int y, int z, int w) const {
+		glUniform4i(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+	}
+
+	void setMat2(const string &name, const glm::mat2 &mat) const {
+		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+
+	void setMat3(const string &name, const glm::mat3 &mat) const {
+		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+
+	void setMat4(const string &name, const glm::mat4 &mat) const {
+		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+
+private:
+	struct CacheHeader {
+		char magic[4];
+		GLenum format;
+		uint32_t length;
+		uint32_t checksum;
+	};
+
+	bool isPending = false;
+	vector<unsigned int> shaders;
+	string cachePath;
+
+	static uint64_t hash(const string &text, uint64_t value = 14695981039346656037ull) {
+		// FNV-1a, including the terminating zero so consecutive texts cannot run into each other
+		for (size_t i = 0; i <= text.size(); i++) {
+			value ^= (unsigned char)text.c_str()[i];
+			value *= 1099511628211ull;
+		}
+		return value;
+	}
+
+	// load the cached binary of the sources if there is one, otherwise start compiling and linking them
+	void build(const GLenum *types, const string *codes, unsigned int count) {
+		ID = glCreateProgram();
+
+		if (!CacheDirectory().empty()) {
+			GLint binaryFormatCount = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+			if (binaryFormatCount > 0) {
+				// A binary only suits the driver it came from
+				uint64_t key = hash((const char*)glGetString(GL_VENDOR));
+				key = hash((const char*)glGetString(GL_RENDERER), key);
+				key = hash((const char*)glGetString(GL_VERSION), key);
+				for (unsigned int i = 0; i < count; i++) {
+					key = hash(to_string(types[i]), key);
+					key = hash(codes[i], key);
+				}
+				char name[32];
+				snprintf(name, sizeof(name), "%016llx.program", (unsigned long long)key);
+				cachePath = CacheDirectory() + "/" + name;
+
+				if (loadBinary()) {
+					return;
+				}
+			}
+		}
+
+		for (unsigned int i = 0; i < count; i++) {
+			const char* shaderCode = codes[i].c_str();
+			unsigned int shader = glCreateShader(types[i]);
+			glShaderSource(shader, 1, &shaderCode, NULL);
+			glCompileShader(shader);
+			glAttachShader(ID, shader);
+			shaders.push_back(shader);
+		}
+
+		// shader program
+		if (!cachePath.empty()) {
+			glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+		glLinkProgram(ID);
+		isPending = true;
+	}
+
+	// wait for the compile and link, print their errors if any, and cache the linked binary
+	void finish() {
+		isPending = false;
+		for (unsigned int shader : shaders) {
+			GLint type;
+			glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+			checkCompileErrors(shader, type == GL_COMPUTE_SHADER ? "COMPUTE" : type == GL_VERTEX_SHADER ? "VERTEX" : type == GL_FRAGMENT_SHADER ? "FRAGMENT" : "GEOMETRY");
+		}
+		bool isLinked = checkCompileErrors(ID, "PROGRAM");
+
+		// delete the shaders as they're linked into our program now and no longer necessary
+		for (unsigned int shader : shaders) {
+			glDetachShader(ID, shader);
+			glDeleteShader(shader);
+		}
+		shaders.clear();
+
+		if (isLinked && !cachePath.empty()) {
+			storeBinary();
+		}
+	}
+
+	bool loadBinary() {
+		FILE *file = fopen(cachePath.c_str(), "rb");
+		if (file == NULL) {
+			return false;
+		}
+		CacheHeader header;
+		vector<char> binary;
+		if (fread(&header, sizeof(CacheHeader), 1, file) == 1 && memcmp(header.magic, "SPB1", 4) == 0) {
+			binary.resize(header.length);
+			if (header.length == 0 || fread(&binary[0], 1, header.length, file) != header.length ||
+				(uint32_t)hash(string(binary.begin(), binary.end())) != header.checksum) {
+				binary.clear();
+			}
+		}
+		fclose(file);
+
+		// A binary the driver no longer accepts is compiled again, the program stays usable after a failed load
+		GLint success = 0;
+		if (!binary.empty()) {
+			glProgramBinary(ID, header.format, &binary[0], (GLsizei)binary.size());
+			glGetProgramiv(ID, GL_LINK_STATUS, &success);
+		}
+		if (!success) {
+			cout << "ERROR::SHADER::CACHED_PROGRAM_NOT_VALID " << cachePath << endl;
+		}
+		return success != 0;
+	}
+
+	// Runs sharing the directory may write a binary at the same time, which the checksum rejects on loading
+	void storeBinary() {
+		GLint length = 0;
+		glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) {
+			return;
+		}
+		CacheHeader header;
+		vector<char> binary(length);
+		glGetProgramBinary(ID, length, NULL, &header.format, &binary[0]);
+		memcpy(header.magic, "SPB1", 4);
+		header.length = (uint32_t)length;
+		header.checksum = (uint32_t)hash(string(binary.begin(), binary.end()));
+
+		FILE *file = fopen(cachePath.c_str(), "wb");
+		if (file == NULL) {
+			cout << "ERROR::SHADER::CACHED_PROGRAM_NOT_WRITTEN " << cachePath << endl;
+			return;
+		}
+		bool isWritten = fwrite(&header, sizeof(CacheHeader), 1, file) == 1 && fwrite(&binary[0], 1, binary.size(), file) == binary.size();
+		if (fclose(file) != 0 || !isWritten) {
+			cout << "ERROR::SHADER::CACHED_PROGRAM_NOT_WRITTEN " << cachePath << endl;
+		}
+	}
+
+	// utility function for checking shader compilation/linking errors.
+	// ------------------------------------------------------------------------
+	bool checkCompileErrors(GLuint shader, std::string type)
+	{
+		GLint success;
+		GLchar infoLog[1024];
+		if (type != "PROGRAM")
+		{
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+			if (!success)
+			{
+				glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+				std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+			}
+		}
+		else
+		{
+			glGetProgramiv(shader, GL_LINK_STATUS, &success);
+			if (!success)
+			{
+				glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+				std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+			}
+		}
+		return success != 0;
+	}
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,337 @@
+#ifndef SHARED_MEMORY_COMMUNICATOR_H
+#define SHARED_MEMORY_COMMUNICATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+extern char **environ;
+#endif
+
+using namespace std;
+
+// Message tags, every tag has its own mailbox between two processes so differently tagged messages never mix
+const unsigned int COMMUNICATOR_TAGS = 4;
+const unsigned int COLLECTIVE_TAG = COMMUNICATOR_TAGS - 1; // Reserved for Broadcast and AllReduceMax
+
+// Message passing between local processes with an MPI-like interface (rank, size, send, receive, broadcast, all reduce, barrier)
+// Every ordered pair of processes has one mailbox per tag in a shared memory segment. A mailbox holds one chunk of a message,
+// longer messages are passed through it chunk by chunk. Waiting processes sleep on a futex on Linux and yield elsewhere
+class SharedMemoryCommunicator {
+public:
+	unsigned int Rank;
+	unsigned int Size;
+
+	SharedMemoryCommunicator() {
+		Rank = 0;
+		Size = 1;
+		slotSize = 0;
+		mappingSize = 0;
+		memory = NULL;
+#ifdef _WIN32
+		mapping = NULL;
+#endif
+	}
+
+	// Rank 0 creates the shared memory segment, which must happen before the other ranks are launched and open it
+	// A mailbox holds slotSize bytes, messages that two processes send to each other at the same time must fit in one
+	bool Initialize(const string &name, unsigned int rank, unsigned int size, size_t slotSize) {
+		Rank = rank;
+		Size = size;
+		this->name = name;
+		this->slotSize = slotSize;
+		mappingSize = sizeof(Header) + (size_t)size * size * COMMUNICATOR_TAGS * MailboxSize();
+
+#ifdef _WIN32
+		if (rank == 0) {
+			mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)mappingSize >> 32), (DWORD)mappingSize, name.c_str());
+		}
+		else {
+			mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+		}
+
+		if (mapping == NULL) {
+			cout << "ERROR::SHARED_MEMORY_COMMUNICATOR::SHARED_MEMORY_NOT_OPENED " << name << endl;
+			return false;
+		}
+
+		memory = (char*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, mappingSize);
+#else
+		// POSIX shared memory names start with a slash, a segment left behind by an earlier run is replaced
+		string sharedMemoryName = "/" + name;
+		int file;
+		if (rank == 0) {
+			shm_unlink(sharedMemoryName.c_str());
+			file = shm_open(sharedMemoryName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (file >= 0 && ftruncate(file, mappingSize) != 0) {
+				close(file);
+				file = -1;
+			}
+		}
+		else {
+			file = shm_open(sharedMemoryName.c_str(), O_RDWR, 0600);
+		}
+
+		if (file < 0) {
+			cout << "ERROR::SHARED_MEMORY_COMMUNICATOR::SHARED_MEMORY_NOT_OPENED " << sharedMemoryName << endl;
+			return false;
+		}
+
+		memory = (char*)mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		close(file);
+		if (memory == MAP_FAILED) {
+			memory = NULL;
+		}
+#endif
+
+		if (memory == NULL) {
+			cout << "ERROR::SHARED_MEMORY_COMMUNICATOR::SHARED_MEMORY_NOT_MAPPED " << name << endl;
+			return false;
+		}
+
+		// A new segment is zero filled, which is the empty state of the barrier and every mailbox
+		return true;
+	}
+
+	// Launch ranks 1 to Size - 1 as copies of the executable, which receive their rank as the only argument
+	bool LaunchWorkers(const char *executable) {
+		for (unsigned int rank = 1; rank < Size; rank++) {
+			string rankArgument = to_string(rank);
+
+#ifdef _WIN32
+			string commandLine = "\"" + string(executable) + "\" " + rankArgument;
+			STARTUPINFOA startupInfo;
+			PROCESS_INFORMATION processInfo;
+			ZeroMemory(&startupInfo, sizeof(startupInfo));
+			startupInfo.cb = sizeof(startupInfo);
+
+			if (!CreateProcessA(NULL, &commandLine[0], NULL, NULL, FALSE, 0, NULL, NULL, &startupInfo, &processInfo)) {
+				cout << "ERROR::SHARED_MEMORY_COMMUNICATOR::WORKER_NOT_LAUNCHED " << rank << endl;
+				return false;
+			}
+			CloseHandle(processInfo.hThread);
+			workers.push_back(processInfo.hProcess);
+#else
+			char *arguments[] = { (char*)executable, &rankArgument[0], NULL };
+			pid_t worker;
+
+			if (posix_spawn(&worker, executable, NULL, NULL, arguments, environ) != 0) {
+				cout << "ERROR::SHARED_MEMORY_COMMUNICATOR::WORKER_NOT_LAUNCHED " << rank << endl;
+				return false;
+			}
+			workers.push_back(worker);
+#endif
+		}
+
+		return true;
+	}
+
+	// Blocks until the mailbox has taken the last chunk of the message
+	void Send(unsigned int destination, unsigned int tag, const void *data, size_t bytes) {
+		Mailbox &mailbox = GetMailbox(Rank, destination, tag);
+		const char *source = (const char*)data;
+		size_t offset = 0;
+
+		do {
+			// Wait for the receiver to empty the mailbox, only this process advances the sent count
+			uint32_t sent = mailbox.Sent.load(memory_order_relaxed);
+			uint32_t received;
+			while ((received = mailbox.Received.load(memory_order_acquire)) != sent) {
+				WaitWhileEqual(mailbox.Received, received);
+			}
+
+			size_t chunkSize = min(slotSize, bytes - offset);
+			memcpy(MailboxData(mailbox), source + offset, chunkSize);
+			offset += chunkSize;
+
+			mailbox.Sent.store(sent + 1, memory_order_release);
+			Wake(mailbox.Sent);
+		} while (offset < bytes);
+	}
+
+	// Blocks until the whole message has arrived, its size must match the one sent
+	void Receive(unsigned int source, unsigned int tag, void *data, size_t bytes) {
+		Mailbox &mailbox = GetMailbox(source, Rank, tag);
+		char *destination = (char*)data;
+		size_t offset = 0;
+
+		do {
+			// Wait for the sender to fill the mailbox, only this process advances the received count
+			uint32_t received = mailbox.Received.load(memory_order_relaxed);
+			uint32_t sent;
+			while ((sent = mailbox.Sent.load(memory_order_acquire)) == received) {
+				WaitWhileEqual(mailbox.Sent, sent);
+			}
+
+			size_t chunkSize = min(slotSize, bytes - offset);
+			memcpy(destination + offset, MailboxData(mailbox), chunkSize);
+			offset += chunkSize;
+
+			mailbox.Received.store(received + 1, memory_order_release);
+			Wake(mailbox.Received);
+		} while (offset < bytes);
+	}
+
+	// Copy root's data to every other rank
+	void Broadcast(void *data, size_t bytes, unsigned int root) {
+		if (Rank == root) {
+			for (unsigned int rank = 0; rank < Size; rank++) {
+				if (rank != root) {
+					Send(rank, COLLECTIVE_TAG, data, bytes);
+				}
+			}
+		}
+		else {
+			Receive(root, COLLECTIVE_TAG, data, bytes);
+		}
+	}
+
+	// Replace every value with its max over all ranks
+	void AllReduceMax(float *values, unsigned int count) {
+		if (Rank == 0) {
+			vector<float> rankValues(count);
+			for (unsigned int rank = 1; rank < Size; rank++) {
+				Receive(rank, COLLECTIVE_TAG, &rankValues[0], count * sizeof(float));
+				for (unsigned int i = 0; i < count; i++) {
+					values[i] = max(values[i], rankValues[i]);
+				}
+			}
+		}
+		else {
+			Send(0, COLLECTIVE_TAG, values, count * sizeof(float));
+		}
+
+		Broadcast(values, count * sizeof(float), 0);
+	}
+
+	// Blocks until every rank has reached the barrier
+	void Barrier() {
+		Header &header = *(Header*)memory;
+		uint32_t generation = header.BarrierGeneration.load(memory_order_acquire);
+
+		if (header.BarrierCount.fetch_add(1, memory_order_acq_rel) + 1 == Size) {
+			header.BarrierCount.store(0, memory_order_relaxed);
+			header.BarrierGeneration.store(generation + 1, memory_order_release);
+			Wake(header.BarrierGeneration);
+		}
+		else {
+			while (header.BarrierGeneration.load(memory_order_acquire) == generation) {
+				WaitWhileEqual(header.BarrierGeneration, generation);
+			}
+		}
+	}
+
+	// Rank 0 waits for the workers to exit before it removes the shared memory segment
+	void Finalize() {
+		if (memory == NULL) {
+			return;
+		}
+
+#ifdef _WIN32
+		for (size_t i = 0; i < workers.size(); i++) {
+			WaitForSingleObject(workers[i], INFINITE);
+			CloseHandle(workers[i]);
+		}
+		UnmapViewOfFile(memory);
+		CloseHandle(mapping);
+		mapping = NULL;
+#else
+		for (size_t i = 0; i < workers.size(); i++) {
+			waitpid(workers[i], NULL, 0);
+		}
+		munmap(memory, mappingSize);
+		if (Rank == 0) {
+			shm_unlink(("/" + name).c_str());
+		}
+#endif
+		workers.clear();
+		memory = NULL;
+	}
+
+private:
+	struct Header {
+		atomic<uint32_t> BarrierCount;
+		atomic<uint32_t> BarrierGeneration;
+	};
+
+	// The counts of chunks put into and taken out of the mailbox, it is full while they differ
+	// The chunk follows the counts, which sit on their own cache line
+	struct Mailbox {
+		atomic<uint32_t> Sent;
+		atomic<uint32_t> Received;
+	};
+
+	string name;
+	size_t slotSize;
+	size_t mappingSize;
+	char *memory;
+
+#ifdef _WIN32
+	HANDLE mapping;
+	vector<HANDLE> workers;
+#else
+	vector<pid_t> workers;
+#endif
+
+	size_t MailboxSize() const {
+		return 64 + (slotSize + 63) / 64 * 64;
+	}
+
+	Mailbox &GetMailbox(unsigned int source, unsigned int destination, unsigned int tag) {
+		size_t mailbox = ((size_t)source * Size + destination) * COMMUNICATOR_TAGS + tag;
+		return *(Mailbox*)(memory + sizeof(Header) + mailbox * MailboxSize());
+	}
+
+	char *MailboxData(Mailbox &mailbox) {
+		return (char*)&mailbox + 64;
+	}
+
+	// Sleep until the word may no longer hold the value, a spurious return only costs another check
+	void WaitWhileEqual(atomic<uint32_t> &word, uint32_t value) {
+		// Short waits are common between neighbors stepping in lock step, spin a little before sleeping
+		for (int i = 0; i < 1024; i++) {
+			if (word.load(memory_order_acquire) != value) {
+				return;
+			}
+		}
+
+#ifdef _WIN32
+		// WaitOnAddress only works within a process, so waits across processes yield instead
+		SwitchToThread();
+#elif defined(__linux__)
+		syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT, value, NULL, NULL, 0);
+#else
+		// No futex on other POSIX systems, the waiting process yields and checks again
+		sched_yield();
+#endif
+	}
+
+	void Wake(atomic<uint32_t> &word) {
+#ifdef __linux__
+		syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+	}
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+#ifndef STRIP_DOMAIN_H
+#define STRIP_DOMAIN_H
+
+#include <glad/glad.h>
+
+#include "sharedMemoryCommunicator.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Message tags of a strip domain
+const unsigned int HALO_TAG = 0;
+const unsigned int GATHER_TAG = 1;
+
+// Most textures exchanged at once, which the communicator mailboxes are sized for
+const unsigned int MAX_HALO_FIELDS = 2;
+
+// A grid split into horizontal strips of rows, one per process. Every process simulates its own strip together with
+// Halo rows of its neighbors' strips, which are exchanged between the passes that read across the strip border
+class StripDomain {
+public:
+	SharedMemoryCommunicator Communicator;
+
+	// domain attributes
+	unsigned int Width;
+	unsigned int Height;
+	unsigned int Halo;
+
+	// Rows owned by this process
+	unsigned int FirstRow;
+	unsigned int EndRow;
+
+	// Rows held by the simulation textures of this process, the owned rows plus the halos clipped to the domain
+	unsigned int TextureFirstRow;
+	unsigned int TextureHeight;
+
+	// constructor only records the layout, the processes are connected by Initialize
+	StripDomain(unsigned int width, unsigned int height, unsigned int halo) {
+		Width = width;
+		Height = height;
+		Halo = halo;
+		FirstRow = 0;
+		EndRow = height;
+		TextureFirstRow = 0;
+		TextureHeight = height;
+	}
+
+	// Connect to the other processes, rank 0 launches them from the executable
+	// Every strip must own at least Halo rows
+	bool Initialize(const string &name, unsigned int rank, unsigned int size, const char *executable) {
+		size_t haloSize = (size_t)Width * Halo * 4 * sizeof(float) * MAX_HALO_FIELDS;
+		if (!Communicator.Initialize(name, rank, size, max(haloSize, (size_t)1 << 20))) {
+			return false;
+		}
+
+		if (rank == 0 && !Communicator.LaunchWorkers(executable)) {
+			return false;
+		}
+
+		FirstRow = StripFirstRow(rank);
+		EndRow = StripFirstRow(rank + 1);
+		TextureFirstRow = FirstRow - min(FirstRow, Halo);
+		TextureHeight = min(Height, EndRow + Halo) - TextureFirstRow;
+
+		hostBuffer.resize((size_t)Width * max(Halo, EndRow - FirstRow) * 4 * MAX_HALO_FIELDS);
+
+		return true;
+	}
+
+	// First row owned by a rank, the remainder rows go to the last strips
+	unsigned int StripFirstRow(unsigned int rank) const {
+		return Height / Communicator.Size * rank + max(0, (int)(rank + Height % Communicator.Size) - (int)Communicator.Size);
+	}
+
+	// Replace the halo rows of the textures with the rows owned by the neighboring processes
+	void ExchangeHalos(const unsigned int *textureIDs, unsigned int count) {
+		size_t bandSize = (size_t)Width * Halo * 4;
+		GLsizei bandBytes = (GLsizei)(bandSize * sizeof(float));
+		const unsigned int neighbors[2] = { Communicator.Rank - 1, Communicator.Rank + 1 };
+		const bool isNeighbor[2] = { Communicator.Rank > 0, Communicator.Rank + 1 < Communicator.Size };
+		// Rows sent to and received from the neighbor above and the one below, in texture rows
+		const unsigned int sentRows[2] = { FirstRow - TextureFirstRow, EndRow - Halo - TextureFirstRow };
+		const unsigned int receivedRows[2] = { 0, EndRow - TextureFirstRow };
+
+		// Make the image stores of the simulation passes visible to the read back
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		// Both neighbors are sent to before either is received from, a halo message fits in a mailbox so neither send blocks
+		for (int side = 0; side < 2; side++) {
+			if (!isNeighbor[side]) {
+				continue;
+			}
+
+			for (unsigned int field = 0; field < count; field++) {
+				glGetTextureSubImage(textureIDs[field], 0, 0, sentRows[side], 0, Width, Halo, 1, GL_RGBA, GL_FLOAT, bandBytes, &hostBuffer[field * bandSize]);
+			}
+			Communicator.Send(neighbors[side], HALO_TAG, &hostBuffer[0], count * bandSize * sizeof(float));
+		}
+
+		for (int side = 0; side < 2; side++) {
+			if (!isNeighbor[side]) {
+				continue;
+			}
+
+			Communicator.Receive(neighbors[side], HALO_TAG, &hostBuffer[0], count * bandSize * sizeof(float));
+			for (unsigned int field = 0; field < count; field++) {
+				glBindTexture(GL_TEXTURE_2D, textureIDs[field]);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, receivedRows[side], Width, Halo, GL_RGBA, GL_FLOAT, &hostBuffer[field * bandSize]);
+			}
+		}
+
+		// Make the uploaded rows visible to the image loads of the simulation passes
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	}
+
+	// Share rank 0's frame time and number of simulation steps, so every process steps the same way
+	// Returns false once rank 0 has passed isLastFrame
+	bool SynchronizeFrame(float &deltaTime, int &simulationSteps, bool isLastFrame) {
+		float frame[3] = { deltaTime, (float)simulationSteps, isLastFrame ? 1.0f : 0.0f };
+		Communicator.Broadcast(frame, sizeof(frame), 0);
+
+		deltaTime = frame[0];
+		simulationSteps = (int)frame[1];
+
+		return frame[2] == 0.0f;
+	}
+
+	// Assemble the owned rows of the column data and water data of every process in rank 0's full size render textures
+	void GatherRenderTextures(unsigned int columnDataTextureID, unsigned int waterDataTextureID, unsigned int renderColumnDataTextureID, unsigned int renderWaterDataTextureID) {
+		unsigned int rows = EndRow - FirstRow;
+		size_t imageSize = (size_t)Width * rows * 4;
+
+		// Make the image stores of the simulation passes visible to the copies
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		if (Communicator.Rank > 0) {
+			GLsizei imageBytes = (GLsizei)(imageSize * sizeof(float));
+			glGetTextureSubImage(columnDataTextureID, 0, 0, FirstRow - TextureFirstRow, 0, Width, rows, 1, GL_RGBA, GL_FLOAT, imageBytes, &hostBuffer[0]);
+			glGetTextureSubImage(waterDataTextureID, 0, 0, FirstRow - TextureFirstRow, 0, Width, rows, 1, GL_RGBA, GL_FLOAT, imageBytes, &hostBuffer[imageSize]);
+			Communicator.Send(0, GATHER_TAG, &hostBuffer[0], 2 * imageSize * sizeof(float));
+			return;
+		}
+
+		glCopyImageSubData(columnDataTextureID, GL_TEXTURE_2D, 0, 0, FirstRow - TextureFirstRow, 0, renderColumnDataTextureID, GL_TEXTURE_2D, 0, 0, FirstRow, 0, Width, rows, 1);
+		glCopyImageSubData(waterDataTextureID, GL_TEXTURE_2D, 0, 0, FirstRow - TextureFirstRow, 0, renderWaterDataTextureID, GL_TEXTURE_2D, 0, 0, FirstRow, 0, Width, rows, 1);
+
+		vector<float> strip;
+		for (unsigned int rank = 1; rank < Communicator.Size; rank++) {
+			unsigned int stripFirstRow = StripFirstRow(rank);
+			unsigned int stripRows = StripFirstRow(rank + 1) - stripFirstRow;
+			size_t stripSize = (size_t)Width * stripRows * 4;
+
+			strip.resize(2 * stripSize);
+			Communicator.Receive(rank, GATHER_TAG, &strip[0], 2 * stripSize * sizeof(float));
+
+			glBindTexture(GL_TEXTURE_2D, renderColumnDataTextureID);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, stripFirstRow, Width, stripRows, GL_RGBA, GL_FLOAT, &strip[0]);
+			glBindTexture(GL_TEXTURE_2D, renderWaterDataTextureID);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, stripFirstRow, Width, stripRows, GL_RGBA, GL_FLOAT, &strip[stripSize]);
+		}
+	}
+
+private:
+	// Staging for the halo bands and the gathered rows
+	vector<float> hostBuffer;
+};
+#endif
\ No newline at end of file
@@ -1,75 +1,86 @@
-#version 460 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoords;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-uniform sampler2D columnDataTexture;
-uniform sampler2D waterDataTexture;
-uniform float size;
-uniform float maxVegetationValue;
-
-uniform vec3 terrainColor;
-uniform vec3 vegetationColor;
-uniform vec3 deadVegetationColor;
-uniform vec3 waterColor;
-uniform vec3 terrainSpecularColor;
-uniform vec3 waterSpecularColor;
-uniform float terrainShininess;
-uniform float waterShininess;
-
-out vec3 Normal;
-out vec3 FragPos;
-out vec2 TexCoords;
-out vec3 VertexColor;
-out vec3 VertexSpecularColor;
-out float VertexShininess;
-
-float Height(vec4 c, vec4 w){
-	return (c.g + w.a + c.b + c.a) * size;
-}
-
-void main()
-{
-	vec4 columnDataTextureValue = texture(columnDataTexture, aTexCoords);
-	vec4 waterDataTextureValue = texture(waterDataTexture, aTexCoords);
-	
-	vec3 newPosition = aPos;
-	float newY = Height(columnDataTextureValue, waterDataTextureValue);
-	newPosition.y = newY;
-	
-	vec3 newNormal;
-	vec2 textureSize = textureSize(columnDataTexture, 0);
-	vec2 texelSize = vec2(1.0f / textureSize.x, 1.0f / textureSize.y);
-	vec4 leftColumnData = textureOffset(columnDataTexture, aTexCoords, ivec2(-1, 0));
-	vec4 leftWaterData = textureOffset(waterDataTexture, aTexCoords, ivec2(-1, 0));
-	vec4 rightColumnData = textureOffset(columnDataTexture, aTexCoords, ivec2(1, 0));
-	vec4 rightWaterData = textureOffset(waterDataTexture, aTexCoords, ivec2(1, 0));
-	vec4 topColumnData = textureOffset(columnDataTexture, aTexCoords, ivec2(0, 1));
-	vec4 topWaterData = textureOffset(waterDataTexture, aTexCoords, ivec2(0, 1));
-	vec4 bottomColumnData = textureOffset(columnDataTexture, aTexCoords, ivec2(0, -1));
-	vec4 bottomWaterData = textureOffset(waterDataTexture, aTexCoords, ivec2(0, -1));
-
-	vec3 tempTerrainColor = terrainColor;
-	if(columnDataTextureValue.b > 0){
-		tempTerrainColor = mix(tempTerrainColor, vegetationColor, (columnDataTextureValue.b / maxVegetationValue));
-	}
-
-	if(waterDataTextureValue.a > 0){
-		tempTerrainColor = mix(tempTerrainColor, deadVegetationColor, waterDataTextureValue.a / maxVegetationValue);
-	}
-
-	VertexColor = tempTerrainColor;
-	VertexSpecularColor = terrainSpecularColor;
-	VertexShininess = terrainShininess;
-
-	newNormal = vec3(Height(leftColumnData, leftWaterData) - Height(rightColumnData, rightWaterData), 2 * texelSize.x, Height(bottomColumnData, bottomWaterData) - Height(topColumnData, topWaterData));
-	newNormal = normalize(newNormal);
-
-    gl_Position = projection * view * model * vec4(newPosition, 1.0);
-	Normal = mat3(transpose(inverse(model))) * newNormal;
-	FragPos = vec3(model * vec4(newPosition, 1.0));
-	TexCoords = aTexCoords;	
+#version 460 core
+// Visible patches left by ChunkedTerrain's culling, one per instance: origin and vertex spacing in texels, and its level of detail
+layout(std430, binding = 3) readonly buffer Patches{
+	vec4 patches[];
+};
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Render data of the terrain and water surface texels, see renderPrep.ComputeShader
+uniform usampler2DArray renderDataTexture;
+uniform mat3 normalMatrix;
+
+// Level of detail settings, see ChunkedTerrain
+uniform vec3 lodCenter; // Eye position in model space
+uniform vec2 morphRanges[16]; // Distance from which each level morphs to the next coarser one, and where it ends
+uniform vec2 gridSize; // Position of the last texel
+uniform float cellSize;
+uniform int patchResolution; // Quads along a patch edge
+
+uniform vec3 terrainColor;
+uniform vec3 vegetationColor;
+uniform vec3 deadVegetationColor;
+uniform vec3 waterColor;
+uniform vec3 terrainSpecularColor;
+uniform vec3 waterSpecularColor;
+uniform float terrainShininess;
+uniform float waterShininess;
+
+out vec3 Normal;
+out vec3 FragPos;
+out vec2 TexCoords;
+out vec3 VertexColor;
+out vec3 VertexSpecularColor;
+out float VertexShininess;
+
+const int TERRAIN_LAYER = 0;
+const int WATER_LAYER = 1;
+
+float Height(uvec4 renderData){
+	return uintBitsToFloat(renderData.x);
+}
+
+vec3 SurfaceNormal(uvec4 renderData){
+	vec2 normal = unpackSnorm2x16(renderData.y);
+	return vec3(normal.x, sqrt(max(0.0f, 1.0f - dot(normal, normal))), normal.y);
+}
+
+// Texel position of a patch vertex, whose odd vertices slide onto their even neighbors as it morphs to the next coarser level
+// The morph follows the distance from the eye to the terrain below the vertex, the same for the terrain and the water surface
+vec2 GridPosition(){
+	// The patch vertex index is i + j * (patchResolution + 1) for patch vertex (i, j)
+	vec4 aPatch = patches[gl_InstanceID];
+	vec2 aGridPosition = vec2(gl_VertexID % (patchResolution + 1), gl_VertexID / (patchResolution + 1));
+	vec2 gridPosition = min(aPatch.xy + aGridPosition * aPatch.z, gridSize);
+	float terrainHeight = Height(texture(renderDataTexture, vec3(gridPosition / gridSize, TERRAIN_LAYER)));
+	vec3 terrainPosition = vec3(gridPosition.x * cellSize, terrainHeight, gridPosition.y * cellSize);
+
+	vec2 morphRange = morphRanges[int(aPatch.w)];
+	float morph = clamp((distance(terrainPosition, lodCenter) - morphRange.x) / (morphRange.y - morphRange.x), 0.0f, 1.0f);
+	vec2 oddVertex = fract(aGridPosition * 0.5f) * 2.0f;
+
+	return min(aPatch.xy + (aGridPosition - oddVertex * morph) * aPatch.z, gridSize);
+}
+
+void main()
+{
+	vec2 gridPosition = GridPosition();
+	vec2 texCoords = gridPosition / gridSize;
+
+	uvec4 renderData = texture(renderDataTexture, vec3(texCoords, TERRAIN_LAYER));
+	vec3 newPosition = vec3(gridPosition.x * cellSize, Height(renderData), gridPosition.y * cellSize);
+	vec3 newNormal = SurfaceNormal(renderData);
+
+	// Terrain colored by its vegetation and dead vegetation
+	vec2 vegetationFactors = unpackHalf2x16(renderData.z);
+	VertexColor = mix(mix(terrainColor, vegetationColor, vegetationFactors.x), deadVegetationColor, vegetationFactors.y);
+	VertexSpecularColor = terrainSpecularColor;
+	VertexShininess = terrainShininess;
+
+    gl_Position = projection * view * model * vec4(newPosition, 1.0);
+	Normal = normalMatrix * newNormal;
+	FragPos = vec3(model * vec4(newPosition, 1.0));
+	TexCoords = texCoords;	
 }
\ No newline at end of file
@@ -0,0 +1,350 @@
+#ifndef TILED_DOMAIN_H
+#define TILED_DOMAIN_H
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Number of textures carried from one simulation step to the next (column data, water data, flux, regolith flux, velocity)
+const unsigned int TILED_DOMAIN_FIELDS = 5;
+
+// A simulation domain too large for the GPU, split into square tiles kept in host memory or in one file per tile.
+// Every step each tile is uploaded together with a halo band taken from its neighbors' last step, simulated on the
+// GPU and its interior read back. Uploads and read backs each go through two pixel buffers, so the next tile is
+// staged and the previous one written back while the GPU works on the current tile.
+class TiledDomain {
+public:
+	// Rectangle of domain texels
+	struct Region {
+		unsigned int x;
+		unsigned int y;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	// domain attributes
+	unsigned int Width;
+	unsigned int Height;
+	unsigned int TileSize;
+	unsigned int Halo;
+	unsigned int NumberTilesX;
+	unsigned int NumberTilesY;
+
+	// Size of the largest tile region, which the simulation textures are allocated at
+	unsigned int TextureWidth;
+	unsigned int TextureHeight;
+
+	// Downsampled column data and water data of the whole domain, refreshed as tiles are written back
+	unsigned int PreviewWidth;
+	unsigned int PreviewHeight;
+	vector<float> PreviewColumnData;
+	vector<float> PreviewWaterData;
+
+	// pixel buffers for the double buffered uploads and read backs
+	unsigned int UploadBufferIDs[2];
+	unsigned int ReadBackBufferIDs[2];
+
+	// constructor only records the layout, storage is allocated by Allocate so an unused domain costs nothing
+	// An empty directory keeps the tiles in host memory
+	TiledDomain(unsigned int width, unsigned int height, unsigned int tileSize, unsigned int halo, unsigned int previewWidth, unsigned int previewHeight, const string &directory) {
+		Width = width;
+		Height = height;
+		TileSize = tileSize;
+		Halo = halo;
+		NumberTilesX = (width + tileSize - 1) / tileSize;
+		NumberTilesY = (height + tileSize - 1) / tileSize;
+		TextureWidth = min(width, tileSize + 2 * halo);
+		TextureHeight = min(height, tileSize + 2 * halo);
+		PreviewWidth = previewWidth;
+		PreviewHeight = previewHeight;
+		Directory = directory;
+		isTileFileFailed = false;
+	}
+
+	void Allocate() {
+		if (Directory.empty()) {
+			tiles.resize(NumberTiles());
+		}
+
+		PreviewColumnData.assign(PreviewWidth * PreviewHeight * 4, 0.0f);
+		PreviewWaterData.assign(PreviewWidth * PreviewHeight * 4, 0.0f);
+
+		GLsizeiptr uploadSize = (GLsizeiptr)TextureWidth * TextureHeight * 4 * TILED_DOMAIN_FIELDS * sizeof(float);
+		GLsizeiptr readBackSize = (GLsizeiptr)TileSize * TileSize * 4 * TILED_DOMAIN_FIELDS * sizeof(float);
+
+		glGenBuffers(2, UploadBufferIDs);
+		glGenBuffers(2, ReadBackBufferIDs);
+		for (int i = 0; i < 2; i++) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, UploadBufferIDs[i]);
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, uploadSize, NULL, GL_STREAM_DRAW);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, ReadBackBufferIDs[i]);
+			glBufferData(GL_PIXEL_PACK_BUFFER, readBackSize, NULL, GL_STREAM_READ);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	unsigned int NumberTiles() const {
+		return NumberTilesX * NumberTilesY;
+	}
+
+	// Texels owned by a tile
+	Region TileInterior(unsigned int tile) const {
+		Region interior;
+		interior.x = (tile % NumberTilesX) * TileSize;
+		interior.y = (tile / NumberTilesX) * TileSize;
+		interior.width = min(TileSize, Width - interior.x);
+		interior.height = min(TileSize, Height - interior.y);
+
+		return interior;
+	}
+
+	// Texels uploaded for a tile, its interior plus the halo band clipped to the domain
+	// Clipping keeps the domain border at the texture border, where the shaders apply the closed boundary
+	Region TileRegion(unsigned int tile) const {
+		Region interior = TileInterior(tile);
+		Region region;
+		region.x = interior.x - min(interior.x, Halo);
+		region.y = interior.y - min(interior.y, Halo);
+		region.width = min(Width, interior.x + interior.width + Halo) - region.x;
+		region.height = min(Height, interior.y + interior.height + Halo) - region.y;
+
+		return region;
+	}
+
+	// Store the initial data of a tile, laid out as TILED_DOMAIN_FIELDS consecutive RGBA images of the tile interior
+	// False when its tile file could not be written
+	bool StoreTile(unsigned int tile, const float *data) {
+		Region interior = TileInterior(tile);
+		size_t size = (size_t)interior.width * interior.height * 4 * TILED_DOMAIN_FIELDS;
+
+		if (Directory.empty()) {
+			tiles[tile].assign(data, data + size);
+		}
+		else {
+			// A file that did not open, or a failed write or close, leaves the stream failed
+			ofstream tileFile(TileFilePath(tile).c_str(), ios::binary | ios::trunc);
+			tileFile.write((const char*)data, size * sizeof(float));
+			tileFile.close();
+			if (tileFile.fail()) {
+				cout << "ERROR::TILED_DOMAIN::TILE_FILE_NOT_WRITTEN " << TileFilePath(tile) << endl;
+				isTileFileFailed = true;
+				return false;
+			}
+		}
+
+		UpdatePreview(interior, data);
+		return true;
+	}
+
+	// Upload a tile region into the simulation textures, which must be listed in the TILED_DOMAIN_FIELDS order
+	Region BeginTile(unsigned int tile, const unsigned int *textureIDs) {
+		if (tile == 0) {
+			StageTile(0);
+		}
+
+		Region region = TileRegion(tile);
+		GLintptr imageSize = (GLintptr)region.width * region.height * 4 * sizeof(float);
+
+		// Make earlier image stores to the textures visible before they are overwritten
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, UploadBufferIDs[tile % 2]);
+		for (unsigned int field = 0; field < TILED_DOMAIN_FIELDS; field++) {
+			// Texels past a region clipped by the domain border must read as zero, like reads outside a full size texture
+			if (region.width < TextureWidth || region.height < TextureHeight) {
+				glClearTexImage(textureIDs[field], 0, GL_RGBA, GL_FLOAT, NULL);
+			}
+
+			glBindTexture(GL_TEXTURE_2D, textureIDs[field]);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, region.width, region.height, GL_RGBA, GL_FLOAT, (const void*)(field * imageSize));
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		// Make the uploaded texels visible to the image loads of the simulation passes
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+		return region;
+	}
+
+	// Read the tile interior back once its step has been issued, then write back the previous tile and stage the next
+	// one while the GPU is still busy with this tile. False once a tile file could not be read or written, the step is lost
+	bool EndTile(unsigned int tile, const unsigned int *textureIDs) {
+		Region interior = TileInterior(tile);
+		Region region = TileRegion(tile);
+		GLsizei imageSize = interior.width * interior.height * 4 * sizeof(float);
+
+		// Make the image stores of the simulation passes visible to the read back
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, ReadBackBufferIDs[tile % 2]);
+		for (unsigned int field = 0; field < TILED_DOMAIN_FIELDS; field++) {
+			glGetTextureSubImage(textureIDs[field], 0, interior.x - region.x, interior.y - region.y, 0, interior.width, interior.height, 1, GL_RGBA, GL_FLOAT, imageSize, (void*)((GLintptr)field * imageSize));
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		// Start the GPU on this tile before the CPU turns to the neighboring tiles
+		glFlush();
+
+		if (tile > 0) {
+			WriteBackTile(tile - 1);
+		}
+
+		if (tile + 1 < NumberTiles()) {
+			StageTile(tile + 1);
+		}
+
+		return !isTileFileFailed;
+	}
+
+	// Write back the last tile once every tile has been stepped, false as EndTile
+	bool EndStep() {
+		WriteBackTile(NumberTiles() - 1);
+
+		// Every tile now holds the new step, the copies of the last one are stale
+		previousTiles.clear();
+
+		return !isTileFileFailed;
+	}
+
+	// Copy the preview of the domain into the render textures
+	void UploadPreview(unsigned int columnDataTextureID, unsigned int waterDataTextureID) {
+		glBindTexture(GL_TEXTURE_2D, columnDataTextureID);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PreviewWidth, PreviewHeight, GL_RGBA, GL_FLOAT, &PreviewColumnData[0]);
+		glBindTexture(GL_TEXTURE_2D, waterDataTextureID);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PreviewWidth, PreviewHeight, GL_RGBA, GL_FLOAT, &PreviewWaterData[0]);
+	}
+
+private:
+	string Directory;
+
+	// Set once a tile file could not be read or written
+	bool isTileFileFailed;
+
+	// Tile data when the tiles are kept in host memory
+	vector<vector<float>> tiles;
+
+	// Tile data as it was at the start of the step, for the halo bands of tiles that have already been written back
+	map<unsigned int, vector<float>> previousTiles;
+
+	string TileFilePath(unsigned int tile) const {
+		return Directory + "/tile_" + to_string(tile % NumberTilesX) + "_" + to_string(tile / NumberTilesX) + ".bin";
+	}
+
+	// Start of step data of a tile, a tile is loaded before its own write back since it is staged no later than itself
+	const vector<float> &PreviousTile(unsigned int tile) {
+		map<unsigned int, vector<float>>::iterator previousTile = previousTiles.find(tile);
+		if (previousTile != previousTiles.end()) {
+			return previousTile->second;
+		}
+
+		vector<float> &data = previousTiles[tile];
+		if (Directory.empty()) {
+			data = tiles[tile];
+		}
+		else {
+			Region interior = TileInterior(tile);
+			data.resize((size_t)interior.width * interior.height * 4 * TILED_DOMAIN_FIELDS);
+
+			ifstream tileFile(TileFilePath(tile).c_str(), ios::binary);
+			if (!tileFile || !tileFile.read((char*)&data[0], data.size() * sizeof(float))) {
+				cout << "ERROR::TILED_DOMAIN::TILE_FILE_NOT_SUCCESSFULLY_READ " << TileFilePath(tile) << endl;
+				isTileFileFailed = true;
+			}
+		}
+
+		return data;
+	}
+
+	// Assemble a tile region from its own and its neighbors' start of step data into an upload buffer
+	void StageTile(unsigned int tile) {
+		Region region = TileRegion(tile);
+		size_t imageSize = (size_t)region.width * region.height * 4;
+
+		// Tiles before the upper left corner of the halo band are not part of this or any later halo band
+		unsigned int haloTiles = (Halo + TileSize - 1) / TileSize;
+		unsigned int firstNeededTile = tile - min(tile, haloTiles * (NumberTilesX + 1));
+		previousTiles.erase(previousTiles.begin(), previousTiles.lower_bound(firstNeededTile));
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, UploadBufferIDs[tile % 2]);
+		float *staging = (float*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, imageSize * TILED_DOMAIN_FIELDS * sizeof(float), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+		for (unsigned int tileY = region.y / TileSize; tileY <= (region.y + region.height - 1) / TileSize; tileY++) {
+			for (unsigned int tileX = region.x / TileSize; tileX <= (region.x + region.width - 1) / TileSize; tileX++) {
+				unsigned int sourceTile = tileX + tileY * NumberTilesX;
+				Region source = TileInterior(sourceTile);
+				const vector<float> &sourceData = PreviousTile(sourceTile);
+
+				// Overlap of the region with this tile
+				unsigned int x0 = max(region.x, source.x);
+				unsigned int x1 = min(region.x + region.width, source.x + source.width);
+				unsigned int y0 = max(region.y, source.y);
+				unsigned int y1 = min(region.y + region.height, source.y + source.height);
+
+				for (unsigned int field = 0; field < TILED_DOMAIN_FIELDS; field++) {
+					const float *sourceImage = &sourceData[field * (size_t)source.width * source.height * 4];
+					float *stagingImage = staging + field * imageSize;
+
+					for (unsigned int y = y0; y < y1; y++) {
+						memcpy(stagingImage + ((size_t)(y - region.y) * region.width + (x0 - region.x)) * 4,
+							sourceImage + ((size_t)(y - source.y) * source.width + (x0 - source.x)) * 4,
+							(x1 - x0) * 4 * sizeof(float));
+					}
+				}
+			}
+		}
+
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	// Copy the read back interior of a tile into its storage
+	void WriteBackTile(unsigned int tile) {
+		Region interior = TileInterior(tile);
+		size_t size = (size_t)interior.width * interior.height * 4 * TILED_DOMAIN_FIELDS;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, ReadBackBufferIDs[tile % 2]);
+		const float *data = (const float*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size * sizeof(float), GL_MAP_READ_BIT);
+
+		// The start of step data of the tile is still needed by the halo bands of later tiles
+		PreviousTile(tile);
+		StoreTile(tile, data);
+
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	// Point sample the column data and water data of a tile interior into the preview
+	void UpdatePreview(const Region &interior, const float *data) {
+		const float *columnData = data;
+		const float *waterData = data + (size_t)interior.width * interior.height * 4;
+
+		for (unsigned int j = 0; j < PreviewHeight; j++) {
+			unsigned int y = (unsigned int)((unsigned long long)j * Height / PreviewHeight);
+			if (y < interior.y || y >= interior.y + interior.height) {
+				continue;
+			}
+
+			for (unsigned int i = 0; i < PreviewWidth; i++) {
+				unsigned int x = (unsigned int)((unsigned long long)i * Width / PreviewWidth);
+				if (x < interior.x || x >= interior.x + interior.width) {
+					continue;
+				}
+
+				size_t source = ((size_t)(y - interior.y) * interior.width + (x - interior.x)) * 4;
+				size_t destination = ((size_t)j * PreviewWidth + i) * 4;
+				memcpy(&PreviewColumnData[destination], columnData + source, 4 * sizeof(float));
+				memcpy(&PreviewWaterData[destination], waterData + source, 4 * sizeof(float));
+			}
+		}
+	}
+};
+#endif
\ No newline at end of file